@@ -13,18 +13,41 @@
  * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include <rjh/clock_cache.hpp>
+#include <rjh/filtered_unordered_set.hpp>
+#include <rjh/hash.hpp>
+#include <rjh/lru_cache.hpp>
+#include <rjh/probing.hpp>
+#include <rjh/sentinel_unordered_set.hpp>
+#include <rjh/snapshot_unordered_map.hpp>
+#include <rjh/static_unordered_map.hpp>
+#include <rjh/string_map.hpp>
 #include <rjh/unordered_map.hpp>
+#include <rjh/unordered_multimap.hpp>
 #include <rjh/unordered_set.hpp>
+#include <rjh/unordered_split_map.hpp>
+#include <rjh/xor_filter.hpp>
+
+#include "rjh_perf_counters.hpp"
 
 #include <benchmark/benchmark.h>
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <list>
 #include <memory>
+#include <random>
+#include <span>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 static auto benchmark_std_unordered_set_adding_ints(benchmark::State& state) -> void {
-    for (auto _ : state) {
+    for (auto _ : rjh::bench::counted_loop{state}) {
         std::unordered_set<int> set;
         for (auto i = 0; i < 1000000; i++) {
             set.insert(i);
@@ -35,7 +58,7 @@ static auto benchmark_std_unordered_set_adding_ints(benchmark::State& state) ->
 BENCHMARK(benchmark_std_unordered_set_adding_ints);
 
 static auto benchmark_rjh_unordered_set_adding_ints(benchmark::State& state) -> void {
-    for (auto _ : state) {
+    for (auto _ : rjh::bench::counted_loop{state}) {
         rjh::unordered_set<int> set;
         for (auto i = 0; i < 1000000; i++) {
             set.insert(i);
@@ -46,7 +69,7 @@ static auto benchmark_rjh_unordered_set_adding_ints(benchmark::State& state) ->
 BENCHMARK(benchmark_rjh_unordered_set_adding_ints);
 
 static auto benchmark_std_unordered_set_adding_strings(benchmark::State& state) -> void {
-    for (auto _ : state) {
+    for (auto _ : rjh::bench::counted_loop{state}) {
         std::unordered_set<std::string> set;
         for (auto i = 0; i < 1000000; i++) {
             set.insert(std::to_string(i));
@@ -57,7 +80,7 @@ static auto benchmark_std_unordered_set_adding_strings(benchmark::State& state)
 BENCHMARK(benchmark_std_unordered_set_adding_strings);
 
 static auto benchmark_rjh_unordered_set_adding_strings(benchmark::State& state) -> void {
-    for (auto _ : state) {
+    for (auto _ : rjh::bench::counted_loop{state}) {
         rjh::unordered_set<std::string> set;
         for (auto i = 0; i < 1000000; i++) {
             set.insert(std::to_string(i));
@@ -67,8 +90,44 @@ static auto benchmark_rjh_unordered_set_adding_strings(benchmark::State& state)
 
 BENCHMARK(benchmark_rjh_unordered_set_adding_strings);
 
+static auto benchmark_rjh_unordered_set_finding_uint32s(benchmark::State& state) -> void {
+    rjh::unordered_set<std::uint32_t> set;
+    for (std::uint32_t i = 0; i < 1000000; i++) {
+        set.insert(i * 3);
+    }
+
+    for (auto _ : rjh::bench::counted_loop{state}) {
+        auto hits = std::uint32_t{0};
+        for (std::uint32_t i = 0; i < 2000000; i++) {
+            hits += set.contains(i * 3 / 2);
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    state.counters["bytes_per_slot"] = sizeof(rjh::detail::hash_table<std::uint32_t>::bucket);
+}
+
+BENCHMARK(benchmark_rjh_unordered_set_finding_uint32s);
+
+static auto benchmark_rjh_sentinel_unordered_set_finding_uint32s(benchmark::State& state) -> void {
+    rjh::sentinel_unordered_set<std::uint32_t> set;
+    for (std::uint32_t i = 0; i < 1000000; i++) {
+        set.insert(i * 3);
+    }
+
+    for (auto _ : rjh::bench::counted_loop{state}) {
+        auto hits = std::uint32_t{0};
+        for (std::uint32_t i = 0; i < 2000000; i++) {
+            hits += set.contains(i * 3 / 2);
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    state.counters["bytes_per_slot"] = sizeof(rjh::sentinel_unordered_set<std::uint32_t>::value_type);
+}
+
+BENCHMARK(benchmark_rjh_sentinel_unordered_set_finding_uint32s);
+
 static auto benchmark_std_unordered_map_adding_ints(benchmark::State& state) -> void {
-    for (auto _ : state) {
+    for (auto _ : rjh::bench::counted_loop{state}) {
         std::unordered_map<int, int> map;
         auto it = map.begin();
         for (auto i = 0; i < 1000000; i++) {
@@ -80,10 +139,10 @@ static auto benchmark_std_unordered_map_adding_ints(benchmark::State& state) ->
 BENCHMARK(benchmark_std_unordered_map_adding_ints);
 
 static auto benchmark_rjh_unordered_map_adding_ints(benchmark::State& state) -> void {
-    for (auto _ : state) {
+    for (auto _ : rjh::bench::counted_loop{state}) {
         rjh::unordered_map<int, int> map;
         for (auto i = 0; i < 1000000; i++) {
-            map.insert(i, i * 2);
+            map.insert({i, i * 2});
         }
     }
 }
@@ -91,7 +150,7 @@ static auto benchmark_rjh_unordered_map_adding_ints(benchmark::State& state) ->
 BENCHMARK(benchmark_rjh_unordered_map_adding_ints);
 
 static auto benchmark_std_unordered_map_adding_strings(benchmark::State& state) -> void {
-    for (auto _ : state) {
+    for (auto _ : rjh::bench::counted_loop{state}) {
         std::unordered_map<std::string, std::string> map;
         for (auto i = 0; i < 1000000; i++) {
             map.emplace(std::to_string(i), std::to_string(i * 2));
@@ -102,14 +161,906 @@ static auto benchmark_std_unordered_map_adding_strings(benchmark::State& state)
 BENCHMARK(benchmark_std_unordered_map_adding_strings);
 
 static auto benchmark_rjh_unordered_map_adding_strings(benchmark::State& state) -> void {
-    for (auto _ : state) {
+    for (auto _ : rjh::bench::counted_loop{state}) {
         rjh::unordered_map<std::string, std::string> map;
         for (auto i = 0; i < 1000000; i++) {
-            map.insert(std::to_string(i), std::to_string(i * 2));
+            map.insert({std::to_string(i), std::to_string(i * 2)});
         }
     }
 }
 
 BENCHMARK(benchmark_rjh_unordered_map_adding_strings);
 
-BENCHMARK_MAIN();
+static auto benchmark_rjh_string_map_adding_strings(benchmark::State& state) -> void {
+    for (auto _ : rjh::bench::counted_loop{state}) {
+        rjh::string_map<std::string> map;
+        for (auto i = 0; i < 1000000; i++) {
+            map.insert(std::to_string(i), std::to_string(i * 2));
+        }
+    }
+}
+
+BENCHMARK(benchmark_rjh_string_map_adding_strings);
+
+static auto benchmark_std_unordered_map_finding_string_views(benchmark::State& state) -> void {
+    std::unordered_map<std::string, int> map;
+    std::vector<std::string> keys;
+    for (auto i = 0; i < 100000; i++) {
+        keys.push_back("https://example.com/resource/" + std::to_string(i));
+        map.emplace(keys.back(), i);
+    }
+
+    for (auto _ : rjh::bench::counted_loop{state, keys.size()}) {
+        for (const auto& key : keys) {
+            benchmark::DoNotOptimize(map.find(std::string{std::string_view{key}}));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(keys.size()));
+}
+
+BENCHMARK(benchmark_std_unordered_map_finding_string_views);
+
+static auto benchmark_rjh_string_map_finding_string_views(benchmark::State& state) -> void {
+    rjh::string_map<int> map;
+    std::vector<std::string> keys;
+    for (auto i = 0; i < 100000; i++) {
+        keys.push_back("https://example.com/resource/" + std::to_string(i));
+        map.insert(keys.back(), i);
+    }
+
+    for (auto _ : rjh::bench::counted_loop{state, keys.size()}) {
+        for (const auto& key : keys) {
+            benchmark::DoNotOptimize(map.find(std::string_view{key}));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(keys.size()));
+}
+
+BENCHMARK(benchmark_rjh_string_map_finding_string_views);
+
+static auto benchmark_std_unordered_map_erase_if(benchmark::State& state) -> void {
+    rjh::bench::counted_loop loop{state};
+    for (auto _ : loop) {
+        loop.pause();
+        std::unordered_map<int, int> map;
+        for (auto i = 0; i < 1000000; i++) {
+            map.emplace(i, i);
+        }
+        loop.resume();
+
+        std::erase_if(map, [](const auto& pair) { return pair.second % 10 < 3; });
+    }
+}
+
+BENCHMARK(benchmark_std_unordered_map_erase_if);
+
+static auto benchmark_rjh_unordered_map_erase_if(benchmark::State& state) -> void {
+    rjh::bench::counted_loop loop{state};
+    for (auto _ : loop) {
+        loop.pause();
+        rjh::unordered_map<int, int> map;
+        for (auto i = 0; i < 1000000; i++) {
+            map.insert({i, i});
+        }
+        loop.resume();
+
+        map.erase_if([](const auto& pair) { return pair.second % 10 < 3; });
+    }
+}
+
+BENCHMARK(benchmark_rjh_unordered_map_erase_if);
+
+static auto benchmark_std_unordered_map_iterating_sparse(benchmark::State& state) -> void {
+    std::unordered_map<int, int> map;
+    for (auto i = 0; i < 1000000; i++) {
+        map.emplace(i, i);
+    }
+    std::erase_if(map, [](const auto& pair) { return pair.second % 8 != 0; });
+
+    for (auto _ : rjh::bench::counted_loop{state}) {
+        auto sum = std::int64_t{0};
+        for (const auto& [key, value] : map) {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(benchmark_std_unordered_map_iterating_sparse);
+
+static auto benchmark_rjh_unordered_map_iterating_sparse(benchmark::State& state) -> void {
+    rjh::unordered_map<int, int> map;
+    for (auto i = 0; i < 1000000; i++) {
+        map.insert({i, i});
+    }
+    map.erase_if([](const auto& pair) { return pair.second % 8 != 0; });
+
+    for (auto _ : rjh::bench::counted_loop{state}) {
+        auto sum = std::int64_t{0};
+        for (auto it = map.begin(); it != map.end(); ++it) {
+            sum += it.value();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(benchmark_rjh_unordered_map_iterating_sparse);
+
+// A scratch table sized for the worst case, filled with a few hundred entries and cleared, as in per-request reuse.
+template<typename Map>
+static auto fill_and_clear_scratch(benchmark::State& state, Map& map) -> void {
+    for (auto _ : rjh::bench::counted_loop{state}) {
+        for (auto i = 0; i < 300; i++) {
+            map.insert({i * 17, i});
+        }
+        benchmark::DoNotOptimize(map.size());
+        map.clear();
+    }
+}
+
+static auto benchmark_std_unordered_map_clearing_scratch(benchmark::State& state) -> void {
+    std::unordered_map<int, int> map;
+    map.reserve(1 << 18);
+    fill_and_clear_scratch(state, map);
+}
+
+BENCHMARK(benchmark_std_unordered_map_clearing_scratch);
+
+static auto benchmark_rjh_unordered_map_clearing_scratch(benchmark::State& state) -> void {
+    rjh::unordered_map<int, int> map;
+    map.reserve(1 << 18);
+    fill_and_clear_scratch(state, map);
+}
+
+BENCHMARK(benchmark_rjh_unordered_map_clearing_scratch);
+
+static auto benchmark_rjh_generational_unordered_map_clearing_scratch(benchmark::State& state) -> void {
+    rjh::unordered_map<int, int, std::hash<int>, std::equal_to<int>, true> map;
+    map.reserve(1 << 18);
+    fill_and_clear_scratch(state, map);
+}
+
+BENCHMARK(benchmark_rjh_generational_unordered_map_clearing_scratch);
+
+static auto benchmark_std_unordered_set_intersection(benchmark::State& state) -> void {
+    std::unordered_set<int> small, large;
+    for (auto i = 0; i < 1000000; i++) {
+        large.insert(i * 3);
+        if (i % 4 == 0) {
+            small.insert(i * 2);
+        }
+    }
+
+    for (auto _ : rjh::bench::counted_loop{state}) {
+        std::unordered_set<int> result;
+        for (const auto key : small) {
+            if (large.contains(key)) {
+                result.insert(key);
+            }
+        }
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+BENCHMARK(benchmark_std_unordered_set_intersection);
+
+static auto benchmark_rjh_unordered_set_intersection(benchmark::State& state) -> void {
+    rjh::unordered_set<int> small, large;
+    for (auto i = 0; i < 1000000; i++) {
+        large.insert(i * 3);
+        if (i % 4 == 0) {
+            small.insert(i * 2);
+        }
+    }
+
+    for (auto _ : rjh::bench::counted_loop{state}) {
+        auto result = small;
+        result.intersect_with(large);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+BENCHMARK(benchmark_rjh_unordered_set_intersection);
+
+static constexpr std::uint64_t s_filter_key_count = 1000000;
+
+// Nine in ten probes miss. Present keys are multiples of 10 and the probes walk every integer. may_contain is the
+// membership test whose false positive rate is reported, since contains() on a filtered set is exact.
+template<typename Set, typename MayContain>
+static auto find_mostly_missing(benchmark::State& state, const Set& set, MayContain may_contain) -> void {
+    for (auto _ : rjh::bench::counted_loop{state, s_filter_key_count * 10}) {
+        auto hits = std::uint64_t{0};
+        for (std::uint64_t i = 0; i < s_filter_key_count * 10; i++) {
+            hits += set.contains(i);
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(s_filter_key_count * 10));
+
+    auto false_positives = std::uint64_t{0};
+    for (std::uint64_t i = 0; i < s_filter_key_count * 10; i++) {
+        false_positives += i % 10 != 0 && may_contain(i);
+    }
+    state.counters["false_positive_rate"] = static_cast<double>(false_positives) / (s_filter_key_count * 9.0);
+}
+
+static auto benchmark_rjh_unordered_set_finding_mostly_missing(benchmark::State& state) -> void {
+    rjh::unordered_set<std::uint64_t> set;
+    for (std::uint64_t i = 0; i < s_filter_key_count; i++) {
+        set.insert(i * 10);
+    }
+    find_mostly_missing(state, set, [&set](std::uint64_t key) { return set.contains(key); });
+}
+
+BENCHMARK(benchmark_rjh_unordered_set_finding_mostly_missing);
+
+static auto benchmark_rjh_filtered_unordered_set_finding_mostly_missing(benchmark::State& state) -> void {
+    rjh::filtered_unordered_set<std::uint64_t> set;
+    for (std::uint64_t i = 0; i < s_filter_key_count; i++) {
+        set.insert(i * 10);
+    }
+    find_mostly_missing(state, set, [&set](std::uint64_t key) { return set.may_contain(key); });
+}
+
+BENCHMARK(benchmark_rjh_filtered_unordered_set_finding_mostly_missing);
+
+static auto benchmark_rjh_xor_filter_finding_mostly_missing(benchmark::State& state) -> void {
+    rjh::unordered_set<std::uint64_t> set;
+    for (std::uint64_t i = 0; i < s_filter_key_count; i++) {
+        set.insert(i * 10);
+    }
+    const rjh::xor_filter<std::uint64_t> filter{set};
+    find_mostly_missing(state, filter, [&filter](std::uint64_t key) { return filter.contains(key); });
+    state.counters["bits_per_key"] = static_cast<double>(filter.size_in_bytes() * 8) / static_cast<double>(filter.size());
+}
+
+BENCHMARK(benchmark_rjh_xor_filter_finding_mostly_missing);
+
+static auto benchmark_std_unordered_map_transfer_nodes(benchmark::State& state) -> void {
+    rjh::bench::counted_loop loop{state};
+    for (auto _ : loop) {
+        loop.pause();
+        std::unordered_map<std::string, std::string> source, destination;
+        for (auto i = 0; i < 100000; i++) {
+            source.emplace(std::to_string(i), std::to_string(i * 2));
+        }
+        loop.resume();
+
+        for (auto i = 0; i < 100000; i += 2) {
+            destination.insert(source.extract(std::to_string(i)));
+        }
+    }
+}
+
+BENCHMARK(benchmark_std_unordered_map_transfer_nodes);
+
+static auto benchmark_rjh_unordered_map_transfer_nodes(benchmark::State& state) -> void {
+    rjh::bench::counted_loop loop{state};
+    for (auto _ : loop) {
+        loop.pause();
+        rjh::unordered_map<std::string, std::string> source, destination;
+        for (auto i = 0; i < 100000; i++) {
+            source.insert({std::to_string(i), std::to_string(i * 2)});
+        }
+        loop.resume();
+
+        for (auto i = 0; i < 100000; i += 2) {
+            destination.insert(source.extract(std::to_string(i)));
+        }
+    }
+}
+
+BENCHMARK(benchmark_rjh_unordered_map_transfer_nodes);
+
+// state.range(0) is the number of values per key.
+static auto benchmark_std_unordered_multimap_adding_ints(benchmark::State& state) -> void {
+    const auto fan_out = static_cast<int>(state.range(0));
+    for (auto _ : rjh::bench::counted_loop{state}) {
+        std::unordered_multimap<int, int> map;
+        for (auto i = 0; i < 100000; i++) {
+            map.emplace(i / fan_out, i);
+        }
+    }
+}
+
+BENCHMARK(benchmark_std_unordered_multimap_adding_ints)->RangeMultiplier(10)->Range(1, 1000);
+
+static auto benchmark_rjh_unordered_multimap_adding_ints(benchmark::State& state) -> void {
+    const auto fan_out = static_cast<int>(state.range(0));
+    for (auto _ : rjh::bench::counted_loop{state}) {
+        rjh::unordered_multimap<int, int> map;
+        for (auto i = 0; i < 100000; i++) {
+            map.insert({i / fan_out, i});
+        }
+    }
+}
+
+BENCHMARK(benchmark_rjh_unordered_multimap_adding_ints)->RangeMultiplier(10)->Range(1, 1000);
+
+static auto benchmark_std_unordered_multimap_equal_range(benchmark::State& state) -> void {
+    const auto fan_out = static_cast<int>(state.range(0));
+    std::unordered_multimap<int, int> map;
+    for (auto i = 0; i < 100000; i++) {
+        map.emplace(i / fan_out, i);
+    }
+
+    for (auto _ : rjh::bench::counted_loop{state}) {
+        auto sum = 0L;
+        for (auto key = 0; key < 100000 / fan_out; key++) {
+            for (auto [it, last] = map.equal_range(key); it != last; ++it) {
+                sum += it->second;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(benchmark_std_unordered_multimap_equal_range)->RangeMultiplier(10)->Range(1, 1000);
+
+static auto benchmark_rjh_unordered_multimap_equal_range(benchmark::State& state) -> void {
+    const auto fan_out = static_cast<int>(state.range(0));
+    rjh::unordered_multimap<int, int> map;
+    for (auto i = 0; i < 100000; i++) {
+        map.insert({i / fan_out, i});
+    }
+
+    for (auto _ : rjh::bench::counted_loop{state}) {
+        auto sum = 0L;
+        for (auto key = 0; key < 100000 / fan_out; key++) {
+            for (auto [it, last] = map.equal_range(key); it != last; ++it) {
+                sum += it.value();
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(benchmark_rjh_unordered_multimap_equal_range)->RangeMultiplier(10)->Range(1, 1000);
+
+// Keys in [0, universe) drawn from a Zipf distribution with exponent 1, so a small set of keys gets most of the hits.
+using large_value = std::array<std::uint64_t, 25>;
+static constexpr std::uint64_t s_large_value_count = 200000;
+
+// Looks up every key once, half of them absent, so probes cross both hits and misses.
+template<typename Map>
+static auto find_large_values(benchmark::State& state, const Map& map) -> void {
+    for (auto _ : rjh::bench::counted_loop{state, s_large_value_count * 2}) {
+        auto hits = std::uint64_t{0};
+        for (std::uint64_t i = 0; i < s_large_value_count * 2; i++) {
+            hits += map.contains(i * 7);
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(s_large_value_count * 2));
+}
+
+static auto benchmark_rjh_unordered_set_finding_keys(benchmark::State& state) -> void {
+    rjh::unordered_set<std::uint64_t> set;
+    for (std::uint64_t i = 0; i < s_large_value_count; i++) {
+        set.insert(i * 7);
+    }
+    find_large_values(state, set);
+}
+
+BENCHMARK(benchmark_rjh_unordered_set_finding_keys);
+
+static auto benchmark_rjh_unordered_map_finding_large_values(benchmark::State& state) -> void {
+    rjh::unordered_map<std::uint64_t, large_value> map;
+    for (std::uint64_t i = 0; i < s_large_value_count; i++) {
+        map.insert({i * 7, large_value{i}});
+    }
+    find_large_values(state, map);
+}
+
+BENCHMARK(benchmark_rjh_unordered_map_finding_large_values);
+
+static auto benchmark_rjh_unordered_split_map_finding_large_values(benchmark::State& state) -> void {
+    rjh::unordered_split_map<std::uint64_t, large_value> map;
+    for (std::uint64_t i = 0; i < s_large_value_count; i++) {
+        map.insert({i * 7, large_value{i}});
+    }
+    find_large_values(state, map);
+}
+
+BENCHMARK(benchmark_rjh_unordered_split_map_finding_large_values);
+
+static auto zipf_keys(std::size_t count, int universe) -> std::vector<int> {
+    std::vector<double> weights(static_cast<std::size_t>(universe));
+    for (std::size_t i = 0; i < weights.size(); i++) {
+        weights[i] = 1.0 / static_cast<double>(i + 1);
+    }
+
+    std::mt19937 generator{42};
+    std::discrete_distribution<int> distribution{weights.begin(), weights.end()};
+    std::vector<int> keys(count);
+    for (auto& key : keys) {
+        key = distribution(generator);
+    }
+    return keys;
+}
+
+static constexpr std::size_t s_cache_capacity = 10000;
+static constexpr int s_cache_universe = 1000000;
+
+static auto benchmark_std_list_lru_cache_zipf(benchmark::State& state) -> void {
+    const auto keys = zipf_keys(1000000, s_cache_universe);
+    std::list<std::pair<int, int>> recency;
+    std::unordered_map<int, std::list<std::pair<int, int>>::iterator> map;
+    auto hits = 0L;
+
+    for (auto _ : rjh::bench::counted_loop{state, keys.size()}) {
+        for (const auto key : keys) {
+            if (const auto it = map.find(key); it != map.end()) {
+                recency.splice(recency.begin(), recency, it->second);
+                hits++;
+                continue;
+            }
+
+            if (map.size() == s_cache_capacity) {
+                map.erase(recency.back().first);
+                recency.pop_back();
+            }
+            recency.emplace_front(key, key);
+            map.emplace(key, recency.begin());
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(keys.size()));
+    state.counters["hit_rate"] = static_cast<double>(hits) / static_cast<double>(state.iterations() * keys.size());
+}
+
+BENCHMARK(benchmark_std_list_lru_cache_zipf);
+
+static auto benchmark_rjh_lru_cache_zipf(benchmark::State& state) -> void {
+    const auto keys = zipf_keys(1000000, s_cache_universe);
+    rjh::lru_cache<int, int> cache{s_cache_capacity};
+    auto hits = 0L;
+
+    for (auto _ : rjh::bench::counted_loop{state, keys.size()}) {
+        for (const auto key : keys) {
+            if (cache.get(key) != nullptr) {
+                hits++;
+            } else {
+                cache.put(key, key);
+            }
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(keys.size()));
+    state.counters["hit_rate"] = static_cast<double>(hits) / static_cast<double>(state.iterations() * keys.size());
+}
+
+BENCHMARK(benchmark_rjh_lru_cache_zipf);
+
+static auto benchmark_rjh_clock_cache_zipf(benchmark::State& state) -> void {
+    const auto keys = zipf_keys(1000000, s_cache_universe);
+    rjh::clock_cache<int, int> cache{s_cache_capacity};
+    auto hits = 0L;
+
+    for (auto _ : rjh::bench::counted_loop{state, keys.size()}) {
+        for (const auto key : keys) {
+            if (cache.get(key) != nullptr) {
+                hits++;
+            } else {
+                cache.put(key, key);
+            }
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(keys.size()));
+    state.counters["hit_rate"] = static_cast<double>(hits) / static_cast<double>(state.iterations() * keys.size());
+}
+
+BENCHMARK(benchmark_rjh_clock_cache_zipf);
+
+static auto random_ids(std::size_t count) -> std::vector<std::uint64_t> {
+    std::mt19937_64 engine{42};
+    std::vector<std::uint64_t> ids(count);
+    for (auto& id : ids) {
+        id = engine();
+    }
+    return ids;
+}
+
+static auto benchmark_rjh_hash_ids_one_at_a_time(benchmark::State& state) -> void {
+    const auto ids = random_ids(4096);
+    std::vector<std::size_t> hashes(ids.size());
+    const rjh::hash<std::uint64_t> hasher;
+
+    for (auto _ : rjh::bench::counted_loop{state, ids.size()}) {
+        for (std::size_t i = 0; i < ids.size(); i++) {
+            hashes[i] = hasher(ids[i]);
+        }
+        benchmark::DoNotOptimize(hashes.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(ids.size()));
+}
+
+BENCHMARK(benchmark_rjh_hash_ids_one_at_a_time);
+
+static auto benchmark_rjh_hash_ids_batched(benchmark::State& state) -> void {
+    const auto ids = random_ids(4096);
+    std::vector<std::size_t> hashes(ids.size());
+    const rjh::hash<std::uint64_t> hasher;
+
+    for (auto _ : rjh::bench::counted_loop{state, ids.size()}) {
+        hasher.hash_batch(ids, hashes);
+        benchmark::DoNotOptimize(hashes.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(ids.size()));
+}
+
+BENCHMARK(benchmark_rjh_hash_ids_batched);
+
+static auto benchmark_rjh_unordered_set_inserting_ids(benchmark::State& state) -> void {
+    const auto ids = random_ids(1000000);
+
+    for (auto _ : rjh::bench::counted_loop{state, ids.size()}) {
+        rjh::unordered_set<std::uint64_t> set;
+        set.reserve(ids.size());
+        for (const auto id : ids) {
+            set.insert(id);
+        }
+        benchmark::DoNotOptimize(set);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(ids.size()));
+}
+
+BENCHMARK(benchmark_rjh_unordered_set_inserting_ids);
+
+static auto benchmark_rjh_unordered_set_bulk_inserting_ids(benchmark::State& state) -> void {
+    const auto ids = random_ids(1000000);
+
+    for (auto _ : rjh::bench::counted_loop{state, ids.size()}) {
+        rjh::unordered_set<std::uint64_t> set;
+        set.reserve(ids.size());
+        set.insert_bulk(ids);
+        benchmark::DoNotOptimize(set);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(ids.size()));
+}
+
+BENCHMARK(benchmark_rjh_unordered_set_bulk_inserting_ids);
+
+static auto benchmark_rjh_unordered_set_finding_ids(benchmark::State& state) -> void {
+    const auto ids = random_ids(1000000);
+    rjh::unordered_set<std::uint64_t> set;
+    set.insert_bulk(ids);
+
+    for (auto _ : rjh::bench::counted_loop{state, ids.size()}) {
+        auto found = std::size_t{0};
+        for (const auto id : ids) {
+            found += set.contains(id);
+        }
+        benchmark::DoNotOptimize(found);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(ids.size()));
+}
+
+BENCHMARK(benchmark_rjh_unordered_set_finding_ids);
+
+static auto benchmark_rjh_unordered_set_bulk_finding_ids(benchmark::State& state) -> void {
+    const auto ids = random_ids(1000000);
+    rjh::unordered_set<std::uint64_t> set;
+    set.insert_bulk(ids);
+    const auto found = std::make_unique<bool[]>(ids.size());
+
+    for (auto _ : rjh::bench::counted_loop{state, ids.size()}) {
+        benchmark::DoNotOptimize(set.contains_bulk(ids, {found.get(), ids.size()}));
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(ids.size()));
+}
+
+BENCHMARK(benchmark_rjh_unordered_set_bulk_finding_ids);
+
+// Group-by over 100M rows, fed as 100 columnar batches of 1M rows. Each group keeps a sum, count, min and max.
+static constexpr std::size_t s_aggregate_batch_rows = 1000000;
+static constexpr std::size_t s_aggregate_batches = 100;
+
+struct row_stats {
+    long sum{0};
+    long count{0};
+    long min{0};
+    long max{0};
+
+    row_stats() = default;
+
+    row_stats(long value) : sum{value}, count{1}, min{value}, max{value} {
+
+    }
+
+    auto add(long value) noexcept -> void {
+        sum += value;
+        count++;
+        min = std::min(min, value);
+        max = std::max(max, value);
+    }
+};
+
+static auto aggregate_columns(std::uint64_t cardinality) -> std::pair<std::vector<std::uint64_t>, std::vector<long>> {
+    std::mt19937_64 engine{42};
+    std::uniform_int_distribution<std::uint64_t> key_distribution{0, cardinality - 1};
+    std::uniform_int_distribution<long> value_distribution{-1000, 1000};
+    std::vector<std::uint64_t> keys(s_aggregate_batch_rows);
+    std::vector<long> values(s_aggregate_batch_rows);
+    for (std::size_t i = 0; i < s_aggregate_batch_rows; i++) {
+        keys[i] = key_distribution(engine);
+        values[i] = value_distribution(engine);
+    }
+    return {std::move(keys), std::move(values)};
+}
+
+static auto benchmark_std_unordered_map_aggregating_rows(benchmark::State& state) -> void {
+    const auto [keys, values] = aggregate_columns(static_cast<std::uint64_t>(state.range(0)));
+
+    for (auto _ : rjh::bench::counted_loop{state, keys.size() * s_aggregate_batches}) {
+        std::unordered_map<std::uint64_t, row_stats> groups;
+        for (std::size_t batch = 0; batch < s_aggregate_batches; batch++) {
+            for (std::size_t i = 0; i < keys.size(); i++) {
+                if (const auto it = groups.find(keys[i]); it != groups.end()) {
+                    it->second.add(values[i]);
+                } else {
+                    groups.emplace(keys[i], row_stats{values[i]});
+                }
+            }
+        }
+        benchmark::DoNotOptimize(groups);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(keys.size() * s_aggregate_batches));
+}
+
+BENCHMARK(benchmark_std_unordered_map_aggregating_rows)->Arg(1000)->Arg(10000000)->Unit(benchmark::kMillisecond);
+
+static auto benchmark_rjh_unordered_map_aggregating_rows_find_insert(benchmark::State& state) -> void {
+    const auto [keys, values] = aggregate_columns(static_cast<std::uint64_t>(state.range(0)));
+
+    for (auto _ : rjh::bench::counted_loop{state, keys.size() * s_aggregate_batches}) {
+        rjh::unordered_map<std::uint64_t, row_stats> groups;
+        for (std::size_t batch = 0; batch < s_aggregate_batches; batch++) {
+            for (std::size_t i = 0; i < keys.size(); i++) {
+                if (auto it = groups.find(keys[i]); it != groups.end()) {
+                    it.value().add(values[i]);
+                } else {
+                    groups.insert({keys[i], row_stats{values[i]}});
+                }
+            }
+        }
+        benchmark::DoNotOptimize(groups);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(keys.size() * s_aggregate_batches));
+}
+
+BENCHMARK(benchmark_rjh_unordered_map_aggregating_rows_find_insert)
+    ->Arg(1000)->Arg(10000000)->Unit(benchmark::kMillisecond);
+
+static auto benchmark_rjh_unordered_map_aggregating_rows(benchmark::State& state) -> void {
+    const auto [keys, values] = aggregate_columns(static_cast<std::uint64_t>(state.range(0)));
+
+    for (auto _ : rjh::bench::counted_loop{state, keys.size() * s_aggregate_batches}) {
+        rjh::unordered_map<std::uint64_t, row_stats> groups;
+        for (std::size_t batch = 0; batch < s_aggregate_batches; batch++) {
+            groups.aggregate(keys, std::span<const long>{values}, [](row_stats& stats, long value) {
+                stats.add(value);
+            });
+        }
+        benchmark::DoNotOptimize(groups);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(keys.size() * s_aggregate_batches));
+}
+
+BENCHMARK(benchmark_rjh_unordered_map_aggregating_rows)->Arg(1000)->Arg(10000000)->Unit(benchmark::kMillisecond);
+
+// A real-time style cycle on a small map: fill it with 1000 order ids, look each one up, then clear it.
+static constexpr int s_order_count = 1000;
+
+template<typename Map>
+static auto fill_find_clear(benchmark::State& state, Map& map) -> void {
+    for (auto _ : rjh::bench::counted_loop{state, static_cast<std::size_t>(s_order_count) * 2}) {
+        for (auto i = 0; i < s_order_count; i++) {
+            map.insert({i * 7919, i});
+        }
+        for (auto i = 0; i < s_order_count; i++) {
+            benchmark::DoNotOptimize(map.find(i * 7919));
+        }
+        map.clear();
+    }
+
+    state.SetItemsProcessed(state.iterations() * s_order_count * 2);
+}
+
+static auto benchmark_rjh_unordered_map_fill_find_clear(benchmark::State& state) -> void {
+    rjh::unordered_map<int, int> map;
+    fill_find_clear(state, map);
+}
+
+BENCHMARK(benchmark_rjh_unordered_map_fill_find_clear);
+
+static auto benchmark_rjh_static_unordered_map_fill_find_clear(benchmark::State& state) -> void {
+    rjh::static_unordered_map<int, int, s_order_count> map;
+    fill_find_clear(state, map);
+}
+
+BENCHMARK(benchmark_rjh_static_unordered_map_fill_find_clear);
+
+// Head-to-head runs of the engines that can sit behind rjh::unordered_set and rjh::unordered_map. Each workload is
+// registered once per probing policy and every engine sees the same keys in the same order.
+template<typename Probing>
+using engine_set = rjh::unordered_set<std::uint64_t, rjh::hash<std::uint64_t>, false, Probing>;
+
+template<typename Probing>
+static auto benchmark_rjh_engine_inserting_ids(benchmark::State& state) -> void {
+    const auto ids = random_ids(1000000);
+
+    for (auto _ : rjh::bench::counted_loop{state, ids.size()}) {
+        engine_set<Probing> set;
+        for (const auto id : ids) {
+            set.insert(id);
+        }
+        benchmark::DoNotOptimize(set);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(ids.size()));
+}
+
+BENCHMARK_TEMPLATE(benchmark_rjh_engine_inserting_ids, rjh::robin_hood_probing);
+BENCHMARK_TEMPLATE(benchmark_rjh_engine_inserting_ids, rjh::swiss_probing);
+
+// The argument is the number of keys in a table reserved to 2^20 buckets by either engine, so 734003 is a load factor
+// of 0.7.
+template<typename Probing>
+static auto benchmark_rjh_engine_finding_ids(benchmark::State& state) -> void {
+    const auto ids = random_ids(static_cast<std::size_t>(state.range(0)) * 2);
+    const auto present = std::span{ids}.first(ids.size() / 2);
+    engine_set<Probing> set;
+    set.reserve(1 << 19);
+    set.insert_bulk(present);
+
+    // Alternates keys that are present with keys that are not.
+    for (auto _ : rjh::bench::counted_loop{state, ids.size()}) {
+        auto found = std::size_t{0};
+        for (std::size_t i = 0; i < present.size(); i++) {
+            found += set.contains(ids[i]);
+            found += set.contains(ids[present.size() + i]);
+        }
+        benchmark::DoNotOptimize(found);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(ids.size()));
+}
+
+BENCHMARK_TEMPLATE(benchmark_rjh_engine_finding_ids, rjh::robin_hood_probing)->Arg(262144)->Arg(734003);
+BENCHMARK_TEMPLATE(benchmark_rjh_engine_finding_ids, rjh::swiss_probing)->Arg(262144)->Arg(734003);
+
+// A sliding window of 500k live ids: every step erases the oldest id and inserts a new one.
+template<typename Probing>
+static auto benchmark_rjh_engine_erase_churn(benchmark::State& state) -> void {
+    static constexpr std::size_t window = 500000;
+    const auto ids = random_ids(window * 3);
+
+    rjh::bench::counted_loop loop{state, (ids.size() - window) * 2};
+    for (auto _ : loop) {
+        loop.pause();
+        engine_set<Probing> set;
+        set.insert_bulk(std::span{ids}.first(window));
+        loop.resume();
+
+        for (auto i = window; i < ids.size(); i++) {
+            set.erase(ids[i - window]);
+            set.insert(ids[i]);
+        }
+        benchmark::DoNotOptimize(set);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<long>((ids.size() - window) * 2));
+}
+
+BENCHMARK_TEMPLATE(benchmark_rjh_engine_erase_churn, rjh::robin_hood_probing)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(benchmark_rjh_engine_erase_churn, rjh::swiss_probing)->Unit(benchmark::kMillisecond);
+
+// 64-byte string keys, so every key comparison and every moved entry is expensive.
+template<typename Probing>
+static auto benchmark_rjh_engine_finding_large_keys(benchmark::State& state) -> void {
+    const auto ids = random_ids(200000);
+    std::vector<std::string> keys;
+    rjh::unordered_map<std::string, std::size_t, rjh::hash<std::string>, std::equal_to<std::string>, false, Probing> map;
+    for (std::size_t i = 0; i < ids.size(); i++) {
+        keys.push_back(std::string(48, 'k') + std::to_string(ids[i] % 10000000000000000ull));
+        map.insert({keys.back(), i});
+    }
+
+    for (auto _ : rjh::bench::counted_loop{state, keys.size()}) {
+        auto sum = std::size_t{0};
+        for (const auto& key : keys) {
+            sum += map.find(key)->second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(keys.size()));
+}
+
+BENCHMARK_TEMPLATE(benchmark_rjh_engine_finding_large_keys, rjh::robin_hood_probing);
+BENCHMARK_TEMPLATE(benchmark_rjh_engine_finding_large_keys, rjh::swiss_probing);
+
+// Publishing read-only copies of a 1M-entry map to readers: each round applies a batch of writes, whose size is the
+// argument, then publishes a fresh copy while the previous one is still held.
+static constexpr std::size_t s_published_entries = 1000000;
+
+static auto benchmark_rjh_unordered_map_publishing_copies(benchmark::State& state) -> void {
+    const auto writes = static_cast<std::size_t>(state.range(0));
+    const auto ids = random_ids(s_published_entries);
+    rjh::unordered_map<std::uint64_t, std::uint64_t> map;
+    for (const auto id : ids) {
+        map.insert({id, id});
+    }
+    auto published = map;
+
+    auto round = std::size_t{0};
+    for (auto _ : rjh::bench::counted_loop{state}) {
+        for (std::size_t i = 0; i < writes; i++, round++) {
+            map.find(ids[round % ids.size()]).value() = round;
+        }
+        published = map;
+        benchmark::DoNotOptimize(published);
+    }
+}
+
+BENCHMARK(benchmark_rjh_unordered_map_publishing_copies)->Arg(100)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+static auto benchmark_rjh_snapshot_unordered_map_publishing_snapshots(benchmark::State& state) -> void {
+    const auto writes = static_cast<std::size_t>(state.range(0));
+    const auto ids = random_ids(s_published_entries);
+    rjh::snapshot_unordered_map<std::uint64_t, std::uint64_t> map;
+    for (const auto id : ids) {
+        map.insert({id, id});
+    }
+    auto published = map.snapshot();
+
+    auto round = std::size_t{0};
+    for (auto _ : rjh::bench::counted_loop{state}) {
+        for (std::size_t i = 0; i < writes; i++, round++) {
+            map.insert_or_assign(ids[round % ids.size()], round);
+        }
+        published = map.snapshot();
+        benchmark::DoNotOptimize(published);
+    }
+}
+
+BENCHMARK(benchmark_rjh_snapshot_unordered_map_publishing_snapshots)
+    ->Arg(100)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+// Same as BENCHMARK_MAIN, plus --rjh_perf_counters, which adds per-operation hardware counters to every benchmark.
+auto main(int argc, char** argv) -> int {
+    auto kept = 1;
+    for (auto i = 1; i < argc; i++) {
+        if (std::string_view{argv[i]} == "--rjh_perf_counters") {
+            rjh::bench::g_perf_counters_enabled = true;
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    argc = std::min(argc, kept);
+
+    if (rjh::bench::g_perf_counters_enabled && !rjh::bench::perf_counters{}.available()) {
+        std::fprintf(stderr, "perf_event_open is unavailable here, so no hardware counters will be reported\n");
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,232 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <rjh/hash.hpp>
+#include <rjh/hash_analyzer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Reports how well a hasher spreads a sample of keys, and how long Robin Hood probes would get, without building a
+// real table. Keys come from a file with one key per line, or are generated.
+//
+//   rjh_hash_analyzer [--keys=PATH] [--type=u64|u32|string] [--hash=rjh|std]
+//                     [--generate=sequential|strided|random] [--count=N] [--stride=N]
+//                     [--load=0.5,0.75,0.9] [--avalanche-keys=N] [--histogram]
+//
+// Custom hashers, such as those for composite keys, are vetted by calling rjh::analyze_hash with them directly.
+
+namespace {
+struct arguments {
+    std::string keys_path;
+    std::string type{"u64"};
+    std::string hash{"rjh"};
+    std::string generate{"sequential"};
+    std::size_t count{100000};
+    std::uint64_t stride{1024};
+    bool histogram{false};
+    rjh::hash_analysis_options options;
+};
+
+auto usage() -> int {
+    std::fprintf(stderr,
+        "usage: rjh_hash_analyzer [--keys=PATH] [--type=u64|u32|string] [--hash=rjh|std]\n"
+        "                         [--generate=sequential|strided|random] [--count=N] [--stride=N]\n"
+        "                         [--load=0.5,0.75,0.9] [--avalanche-keys=N] [--histogram]\n");
+    return 2;
+}
+
+auto parse_loads(std::string_view list) -> std::vector<double> {
+    std::vector<double> loads;
+    while (!list.empty()) {
+        const auto comma = list.find(',');
+        const auto load = std::strtod(std::string{list.substr(0, comma)}.c_str(), nullptr);
+        if (load > 0 && load < 1) {
+            loads.push_back(load);
+        }
+        list = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1);
+    }
+    return loads;
+}
+
+auto parse_arguments(int argc, char** argv) -> std::optional<arguments> {
+    arguments parsed;
+    for (auto i = 1; i < argc; i++) {
+        const std::string_view argument{argv[i]};
+        const auto equals = argument.find('=');
+        const auto name = argument.substr(0, equals);
+        const auto value = equals == std::string_view::npos ? std::string_view{} : argument.substr(equals + 1);
+
+        if (name == "--keys") {
+            parsed.keys_path = value;
+        } else if (name == "--type" && (value == "u64" || value == "u32" || value == "string")) {
+            parsed.type = value;
+        } else if (name == "--hash" && (value == "rjh" || value == "std")) {
+            parsed.hash = value;
+        } else if (name == "--generate" && (value == "sequential" || value == "strided" || value == "random")) {
+            parsed.generate = value;
+        } else if (name == "--count") {
+            parsed.count = std::strtoull(std::string{value}.c_str(), nullptr, 0);
+        } else if (name == "--stride") {
+            parsed.stride = std::strtoull(std::string{value}.c_str(), nullptr, 0);
+        } else if (name == "--load") {
+            parsed.options.load_factors = parse_loads(value);
+        } else if (name == "--avalanche-keys") {
+            parsed.options.avalanche_keys = std::strtoull(std::string{value}.c_str(), nullptr, 0);
+        } else if (name == "--histogram") {
+            parsed.histogram = true;
+        } else {
+            return std::nullopt;
+        }
+    }
+    return parsed;
+}
+
+auto read_lines(const std::string& path) -> std::optional<std::vector<std::string>> {
+    std::ifstream file{path};
+    if (!file) {
+        return std::nullopt;
+    }
+
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(file, line); ) {
+        if (!line.empty()) {
+            lines.push_back(std::move(line));
+        }
+    }
+    return lines;
+}
+
+auto generate_numbers(const arguments& args) -> std::vector<std::uint64_t> {
+    std::vector<std::uint64_t> numbers(args.count);
+    std::mt19937_64 engine{42};
+    for (std::size_t i = 0; i < numbers.size(); i++) {
+        if (args.generate == "random") {
+            numbers[i] = engine();
+        } else {
+            numbers[i] = args.generate == "strided" ? i * args.stride : i;
+        }
+    }
+    return numbers;
+}
+
+auto print_report(const rjh::hash_report& report, bool histogram) -> void {
+    std::printf("keys             %zu\n", report.keys);
+    std::printf("distinct hashes  %zu%s\n", report.distinct_hashes,
+        report.distinct_hashes < report.keys ? "  (full 64-bit collisions, or duplicate keys in the sample)" : "");
+
+    if (const auto& avalanche = report.avalanche) {
+        std::printf("\navalanche over %zu keys, %zu input bits\n", avalanche->keys, avalanche->input_bits);
+        std::printf("  output bits flipped per input bit  %6.2f  (ideal 32)\n", avalanche->mean_flipped_bits);
+        std::printf("  mean bias                          %6.3f  (ideal 0)\n", avalanche->mean_bias);
+        std::printf("  worst bias                         %6.3f  (0.5 is a bit that never mixes)\n",
+            avalanche->worst_bias);
+        std::printf("  input bits with no effect          %6zu\n", avalanche->dead_input_bits);
+    }
+
+    std::printf("\nbucket distribution at one bucket per key or more\n");
+    std::printf("  %-14s %10s %8s %8s %8s %10s\n", "reduction", "buckets", "empty", "ideal", "largest", "collisions");
+    for (const auto& buckets : report.buckets) {
+        std::printf("  %-14s %10zu %8.3f %8.3f %8zu %9.2fx\n", std::string{rjh::to_string(buckets.reduction)}.c_str(),
+            buckets.buckets, buckets.empty_fraction, buckets.expected_empty_fraction, buckets.largest_bucket,
+            buckets.collision_ratio);
+    }
+
+    std::printf("\nsimulated Robin Hood probe distances, with a uniformly random hash for reference\n");
+    std::printf("  %-14s %6s %10s %10s %8s %6s %6s %10s %10s\n",
+        "reduction", "load", "buckets", "keys", "mean", "p99", "max", "ideal mean", "ideal max");
+    for (const auto& probes : report.probes) {
+        std::printf("  %-14s %6.2f %10zu %10zu %8.2f %6zu %6zu %10.2f %10zu\n",
+            std::string{rjh::to_string(probes.reduction)}.c_str(), probes.load_factor, probes.buckets, probes.keys,
+            probes.mean_distance, probes.p99_distance, probes.max_distance, probes.ideal_mean_distance,
+            probes.ideal_max_distance);
+
+        if (histogram) {
+            for (std::size_t distance = 0; distance < probes.distance_counts.size(); distance++) {
+                if (probes.distance_counts[distance] != 0) {
+                    std::printf("      %6zu %10zu\n", distance, probes.distance_counts[distance]);
+                }
+            }
+        }
+    }
+}
+
+template<typename Key, typename Hash>
+auto analyze(const std::vector<Key>& keys, const arguments& args) -> void {
+    print_report(rjh::analyze_hash(std::span<const Key>{keys}, Hash{}, args.options), args.histogram);
+}
+
+template<typename Key>
+auto analyze(const std::vector<Key>& keys, const arguments& args) -> void {
+    if (args.hash == "rjh") {
+        analyze<Key, rjh::hash<Key>>(keys, args);
+    } else {
+        analyze<Key, std::hash<Key>>(keys, args);
+    }
+}
+} // namespace
+
+auto main(int argc, char** argv) -> int {
+    const auto args = parse_arguments(argc, argv);
+    if (!args) {
+        return usage();
+    }
+
+    std::vector<std::string> lines;
+    if (!args->keys_path.empty()) {
+        auto read = read_lines(args->keys_path);
+        if (!read) {
+            std::fprintf(stderr, "cannot read %s\n", args->keys_path.c_str());
+            return 1;
+        }
+        lines = std::move(*read);
+    }
+
+    if (args->type == "string") {
+        if (lines.empty()) {
+            for (const auto number : generate_numbers(*args)) {
+                lines.push_back("key-" + std::to_string(number));
+            }
+        }
+        analyze(lines, *args);
+        return 0;
+    }
+
+    auto numbers = generate_numbers(*args);
+    if (!args->keys_path.empty()) {
+        numbers.clear();
+        for (const auto& line : lines) {
+            numbers.push_back(std::strtoull(line.c_str(), nullptr, 0));
+        }
+    }
+
+    if (args->type == "u32") {
+        analyze(std::vector<std::uint32_t>(numbers.begin(), numbers.end()), *args);
+    } else {
+        analyze(numbers, *args);
+    }
+    return 0;
+}
@@ -0,0 +1,249 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RJH_PERF_COUNTERS_HPP
+#define RJH_PERF_COUNTERS_HPP
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace rjh::bench {
+// Hardware counters read through Linux perf_event_open, counting user space only so that the default
+// perf_event_paranoid setting allows them. Each event is opened on its own, so a CPU or VM that lacks one still
+// reports the others, and on other platforms, or where perf events are blocked, every event is simply unavailable.
+// When there are more events than hardware counters the kernel multiplexes them, so each count is scaled by how long
+// its event was enabled over how long it actually ran, and an event that never ran is reported as unavailable.
+class perf_counters final {
+public:
+    static constexpr std::size_t s_event_count = 5;
+    static constexpr std::array<std::string_view, s_event_count> s_names{
+        "cycles",
+        "instructions",
+        "branch_misses",
+        "l1d_misses",
+        "llc_misses",
+    };
+
+    using counts = std::array<std::optional<std::uint64_t>, s_event_count>;
+
+    perf_counters() noexcept {
+#if defined(__linux__)
+        constexpr auto l1d_read_miss = PERF_COUNT_HW_CACHE_L1D
+            | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+            | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+        m_fds[0] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        m_fds[1] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        m_fds[2] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+        m_fds[3] = open(PERF_TYPE_HW_CACHE, l1d_read_miss);
+        m_fds[4] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+#endif
+    }
+
+    ~perf_counters() {
+#if defined(__linux__)
+        for (const auto fd : m_fds) {
+            if (fd != -1) {
+                close(fd);
+            }
+        }
+#endif
+    }
+
+    perf_counters(const perf_counters&) = delete;
+    perf_counters& operator=(const perf_counters&) = delete;
+
+    [[nodiscard]] auto available() const noexcept -> bool {
+        for (const auto fd : m_fds) {
+            if (fd != -1) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    auto reset() noexcept -> void {
+#if defined(__linux__)
+        control(PERF_EVENT_IOC_RESET);
+#endif
+    }
+
+    auto enable() noexcept -> void {
+#if defined(__linux__)
+        control(PERF_EVENT_IOC_ENABLE);
+#endif
+    }
+
+    auto disable() noexcept -> void {
+#if defined(__linux__)
+        control(PERF_EVENT_IOC_DISABLE);
+#endif
+    }
+
+    [[nodiscard]] auto read() const noexcept -> counts {
+        counts result{};
+#if defined(__linux__)
+        for (std::size_t i = 0; i < s_event_count; i++) {
+            // Laid out as requested by read_format: the count, then the time enabled, then the time running.
+            std::uint64_t values[3]{};
+            if (m_fds[i] == -1 || ::read(m_fds[i], values, sizeof(values)) != sizeof(values) || values[2] == 0) {
+                continue;
+            }
+
+            const auto [value, enabled, running] = values;
+            result[i] = running >= enabled
+                ? value
+                : static_cast<std::uint64_t>(static_cast<double>(value) * static_cast<double>(enabled)
+                    / static_cast<double>(running));
+        }
+#endif
+        return result;
+    }
+
+private:
+#if defined(__linux__)
+    static auto open(std::uint32_t type, std::uint64_t config) noexcept -> int {
+        perf_event_attr attributes{};
+        attributes.type = type;
+        attributes.size = sizeof(attributes);
+        attributes.config = config;
+        attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        attributes.disabled = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+    }
+
+    auto control(unsigned long request) noexcept -> void {
+        for (const auto fd : m_fds) {
+            if (fd != -1) {
+                ioctl(fd, request, 0);
+            }
+        }
+    }
+#endif
+
+    std::array<int, s_event_count> m_fds{-1, -1, -1, -1, -1};
+}; // class perf_counters
+
+// Set from the --rjh_perf_counters flag before any benchmark runs.
+inline bool g_perf_counters_enabled = false;
+
+// Drop-in replacement for iterating a benchmark::State. With counters enabled, it counts events across the timed
+// loop only, leaving out setup before and after it, and reports each available event as a per-operation counter
+// once the loop ends. operations is how many operations one iteration performs, matching what the benchmark passes
+// to SetItemsProcessed, or 1 if it reports per iteration. Code inside the loop that should not be measured goes
+// between pause() and resume(), which also pause the benchmark's timer.
+class counted_loop final {
+public:
+    class iterator final {
+    public:
+        iterator(benchmark::State::StateIterator it, counted_loop& loop) : m_iterator{it}, m_loop{&loop} {
+
+        }
+
+        auto operator*() const noexcept -> benchmark::State::StateIterator::Value {
+            return *m_iterator;
+        }
+
+        auto operator++() noexcept -> iterator& {
+            ++m_iterator;
+            return *this;
+        }
+
+        auto operator!=(const benchmark::State::StateIterator& end) const noexcept -> bool {
+            if (m_iterator != end) {
+                return true;
+            }
+            m_loop->finish();
+            return false;
+        }
+
+    private:
+        benchmark::State::StateIterator m_iterator;
+        counted_loop* m_loop;
+    };
+
+    counted_loop(benchmark::State& state, std::size_t operations = 1) noexcept
+        : m_state{state}
+        , m_operations{operations} {
+        if (g_perf_counters_enabled) {
+            m_counters.emplace();
+        }
+    }
+
+    auto begin() noexcept -> iterator {
+        auto it = m_state.begin();
+        if (m_counters) {
+            m_counters->reset();
+            m_counters->enable();
+        }
+        return {it, *this};
+    }
+
+    auto end() noexcept -> benchmark::State::StateIterator {
+        return m_state.end();
+    }
+
+    auto pause() noexcept -> void {
+        if (m_counters) {
+            m_counters->disable();
+        }
+        m_state.PauseTiming();
+    }
+
+    auto resume() noexcept -> void {
+        m_state.ResumeTiming();
+        if (m_counters) {
+            m_counters->enable();
+        }
+    }
+
+private:
+    auto finish() noexcept -> void {
+        if (!m_counters) {
+            return;
+        }
+
+        m_counters->disable();
+        const auto counts = m_counters->read();
+        const auto operations = static_cast<double>(m_state.iterations()) * static_cast<double>(m_operations);
+        for (std::size_t i = 0; i < perf_counters::s_event_count; i++) {
+            if (counts[i] && operations > 0) {
+                m_state.counters[std::string{perf_counters::s_names[i]}] = static_cast<double>(*counts[i]) / operations;
+            }
+        }
+    }
+
+    benchmark::State& m_state;
+    std::size_t m_operations;
+    std::optional<perf_counters> m_counters;
+}; // class counted_loop
+} // namespace rjh::bench
+
+#endif // #ifndef RJH_PERF_COUNTERS_HPP
@@ -0,0 +1,134 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RJH_CLOCK_CACHE_HPP
+#define RJH_CLOCK_CACHE_HPP
+
+#include "detail/hash_table.hpp"
+#include "detail/pair_hash.hpp"
+#include "hash.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+namespace rjh {
+// A fixed capacity cache that approximates least recently used eviction with the CLOCK algorithm. Each entry carries
+// a referenced bit inline in the hash table, and the clock hand sweeps the bucket array itself. A hit only sets a
+// bit, and eviction clears bits until it finds an entry that has not been used since the hand last passed it. New
+// entries start unreferenced, as in SIEVE, so one-hit wonders are evicted on the first pass.
+template<
+    typename Key,
+    typename Value,
+    concepts::hash_function_object<Key> Hash = rjh::hash<Key>,
+    concepts::key_equal_function_object<Key> KeyEqual = std::equal_to<Key>
+>
+class clock_cache {
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using size_type = std::size_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+
+    explicit clock_cache(size_type capacity) : m_capacity{std::max<size_type>(capacity, 1)} {
+        m_hash_table.reserve(m_capacity);
+    }
+
+    // Returns the cached value and marks it as referenced, or nullptr on a miss. The pointer is invalidated by the
+    // next modification of the cache.
+    auto get(const key_type& key) noexcept -> mapped_type* {
+        const auto it = m_hash_table.find(key);
+        if (it == m_hash_table.end()) {
+            return nullptr;
+        }
+
+        auto& entry = it->key.second;
+        entry.referenced = true;
+        return &entry.value;
+    }
+
+    // Returns the cached value without marking it as referenced, or nullptr on a miss.
+    auto peek(const key_type& key) const noexcept -> const mapped_type* {
+        const auto it = m_hash_table.find(key);
+        return it == m_hash_table.end() ? nullptr : &it->key.second.value;
+    }
+
+    // Inserts or assigns value, evicting an unreferenced entry if the cache is full. A miss hashes and probes the key
+    // once: the eviction runs after the probe, and insertion places the entry from the hash the probe computed.
+    template<typename V> requires std::assignable_from<mapped_type&, V&&>
+    auto put(const key_type& key, V&& value) noexcept -> mapped_type& {
+        const auto [it, inserted] = m_hash_table.find_or_insert(key, [&] {
+            if (m_hash_table.size() == m_capacity) {
+                m_hash_table.sweep_remove(m_hand, [](table_value& pair) {
+                    return !std::exchange(pair.second.referenced, false);
+                });
+            }
+
+            return table_value{key, entry_type{.value = mapped_type(std::forward<V>(value))}};
+        });
+
+        auto& entry = it->key.second;
+        if (!inserted) {
+            entry.value = std::forward<V>(value);
+            entry.referenced = true;
+        }
+        return entry.value;
+    }
+
+    auto erase(const key_type& key) noexcept -> bool {
+        return m_hash_table.remove(key);
+    }
+
+    auto contains(const key_type& key) const noexcept -> bool {
+        return m_hash_table.contains(key);
+    }
+
+    auto clear() noexcept -> void {
+        m_hash_table.clear();
+        m_hand = 0;
+    }
+
+    [[nodiscard]] auto empty() const noexcept -> bool {
+        return m_hash_table.empty();
+    }
+
+    [[nodiscard]] auto size() const noexcept -> size_type {
+        return m_hash_table.size();
+    }
+
+    [[nodiscard]] auto capacity() const noexcept -> size_type {
+        return m_capacity;
+    }
+
+private:
+    struct entry_type {
+        mapped_type value{};
+        bool referenced{false};
+    };
+
+    using table_value = std::pair<key_type, entry_type>;
+    using pair_hash = detail::pair_hash<key_type, entry_type, hasher>;
+    using pair_key_equal = detail::pair_key_equal<key_type, entry_type, key_equal>;
+
+    detail::hash_table<table_value, pair_hash, pair_key_equal> m_hash_table;
+    size_type m_capacity;
+    size_type m_hand{0};
+}; // class clock_cache
+} // namespace rjh
+
+#endif // #ifndef RJH_CLOCK_CACHE_HPP
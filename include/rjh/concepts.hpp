@@ -17,6 +17,8 @@
 #define RJH_CONCEPTS_HPP
 
 #include <concepts>
+#include <cstddef>
+#include <span>
 #include <type_traits>
 
 namespace rjh::concepts {
@@ -25,11 +27,28 @@ concept hash_function_object = requires(T object, K key) {
     { object(key) } -> std::same_as<std::size_t>;
 };
 
+// Hashers that can hash a span of keys in one call, writing one hash per key.
+template<typename T, typename K>
+concept batch_hash_function_object = hash_function_object<T, K>
+    && requires(const T object, std::span<const K> keys, std::span<std::size_t> hashes) {
+    object.hash_batch(keys, hashes);
+};
+
+// Hashers whose output is already well mixed, so tables can reduce it to a bucket index directly.
+template<typename T>
+concept avalanching_hash = requires {
+    typename T::is_avalanching;
+};
+
 template<typename T, typename K>
 concept key_equal_function_object = requires(T object, K key) {
     { object(key, key) } -> std::same_as<bool>;
 };
 
+// Keys that can reserve one of their own values to mark an empty bucket.
+template<typename K>
+concept sentinel_key = std::integral<K> || std::is_pointer_v<K>;
+
 template<typename T>
 concept is_transparent = requires {
     typename T::is_transparent;
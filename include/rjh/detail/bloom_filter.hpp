@@ -0,0 +1,85 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RJH_BLOOM_FILTER_HPP
+#define RJH_BLOOM_FILTER_HPP
+
+#include "hash_mix.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace rjh::detail {
+// A register-blocked Bloom filter over precomputed hashes. Every hash maps to a single 64-bit word and sets
+// s_bits_per_hash bits inside it, so a query costs one memory access. Bits are never cleared, so removed hashes keep
+// matching until the filter is reset.
+class bloom_filter final {
+public:
+    using size_type = std::size_t;
+    using hash_type = std::size_t;
+    using word_type = std::uint64_t;
+
+    // word_count must be a power of two.
+    explicit bloom_filter(size_type word_count = 1) : m_words(word_count) {
+
+    }
+
+    auto add(hash_type hash) noexcept -> void {
+        const auto mixed = mix(hash);
+        m_words[word_index(mixed)] |= mask(mixed);
+    }
+
+    [[nodiscard]] auto may_contain(hash_type hash) const noexcept -> bool {
+        const auto mixed = mix(hash);
+        const auto bits = mask(mixed);
+        return (m_words[word_index(mixed)] & bits) == bits;
+    }
+
+    auto reset(size_type word_count) noexcept -> void {
+        m_words.assign(word_count, word_type{0});
+    }
+
+    [[nodiscard]] auto word_count() const noexcept -> size_type {
+        return m_words.size();
+    }
+
+private:
+    static constexpr size_type s_bits_per_hash = 5;
+
+    // Offsets the hash before mixing so that the word chosen is independent of the hash table's home bucket, which
+    // is derived from mix_hash of the same hash.
+    static auto mix(hash_type hash) noexcept -> hash_type {
+        return mix_hash(hash + 0x9e3779b97f4a7c15ull);
+    }
+
+    auto word_index(hash_type mixed) const noexcept -> size_type {
+        return (mixed >> 32) & (m_words.size() - 1);
+    }
+
+    static auto mask(hash_type mixed) noexcept -> word_type {
+        auto bits = word_type{0};
+        for (size_type i = 0; i < s_bits_per_hash; i++) {
+            bits |= word_type{1} << ((mixed >> (i * 6)) & 63);
+        }
+        return bits;
+    }
+
+    std::vector<word_type> m_words;
+}; // class bloom_filter
+} // namespace rjh::detail
+
+#endif // #ifndef RJH_BLOOM_FILTER_HPP
@@ -0,0 +1,495 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RJH_COW_HASH_TABLE_HPP
+#define RJH_COW_HASH_TABLE_HPP
+
+#include "../concepts.hpp"
+#include "../hash.hpp"
+#include "hash_mix.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace rjh::detail {
+// A Robin Hood map whose bucket array is split into reference-counted chunks of up to s_chunk_size buckets. Copying
+// the table, or taking a view of it, only copies the chunk pointers. A write first checks that the chunk it is about
+// to modify has no other owner and copies that chunk if it does, so a view stays unchanged while the table keeps
+// taking writes, and the cost of keeping one is the chunks written since. Chunk counts are atomic, so views and copies
+// may be read and released on other threads while one thread writes to the table.
+template<
+    typename Key,
+    typename Mapped,
+    concepts::hash_function_object<Key> Hash = rjh::hash<Key>,
+    concepts::key_equal_function_object<Key> KeyEqual = std::equal_to<Key>
+>
+class cow_hash_table final {
+public:
+    using key_type = Key;
+    using mapped_type = Mapped;
+    using value_type = std::pair<key_type, mapped_type>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using hash_type = std::size_t;
+    using key_equal = KeyEqual;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    struct bucket {
+        value_type value{};
+        hash_type hash{};
+        // One more than the entry's probe distance while occupied, 0 while empty.
+        size_type distance{0};
+    };
+
+private:
+    struct chunk {
+        std::atomic<size_type> references{1};
+        std::vector<bucket> buckets;
+
+        explicit chunk(size_type count) : buckets(count) {
+
+        }
+
+        chunk(const chunk& other) : buckets{other.buckets} {
+
+        }
+    };
+
+    // Shares ownership of a chunk. The count is released with release ordering and checked by unique() with acquire
+    // ordering, so once the writer sees itself as the only owner, every read made through a released reference has
+    // finished.
+    class chunk_ref final {
+    public:
+        explicit chunk_ref(chunk* pointer) noexcept : m_chunk{pointer} {
+
+        }
+
+        ~chunk_ref() {
+            release();
+        }
+
+        chunk_ref(const chunk_ref& other) noexcept : m_chunk{other.m_chunk} {
+            m_chunk->references.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        chunk_ref(chunk_ref&& other) noexcept : m_chunk{std::exchange(other.m_chunk, nullptr)} {
+
+        }
+
+        chunk_ref& operator=(chunk_ref other) noexcept {
+            std::swap(m_chunk, other.m_chunk);
+            return *this;
+        }
+
+        auto operator*() const noexcept -> chunk& {
+            return *m_chunk;
+        }
+
+        auto operator->() const noexcept -> chunk* {
+            return m_chunk;
+        }
+
+        [[nodiscard]] auto unique() const noexcept -> bool {
+            return m_chunk->references.load(std::memory_order_acquire) == 1;
+        }
+
+    private:
+        auto release() noexcept -> void {
+            if (m_chunk != nullptr && m_chunk->references.fetch_sub(1, std::memory_order_release) == 1) {
+                std::atomic_thread_fence(std::memory_order_acquire);
+                delete m_chunk;
+            }
+        }
+
+        chunk* m_chunk;
+    };
+
+    struct storage {
+        std::vector<chunk_ref> chunks;
+        size_type capacity{0};
+        size_type chunk_shift{0};
+
+        explicit storage(size_type bucket_count) noexcept
+            : capacity{bucket_count}
+            , chunk_shift{static_cast<size_type>(std::countr_zero(std::min(bucket_count, s_chunk_size)))} {
+            const auto chunk_count = bucket_count >> chunk_shift;
+            chunks.reserve(chunk_count);
+            for (size_type i = 0; i < chunk_count; i++) {
+                chunks.emplace_back(new chunk(size_type{1} << chunk_shift));
+            }
+        }
+
+        auto at(size_type index) const noexcept -> const bucket& {
+            return chunks[index >> chunk_shift]->buckets[index & ((size_type{1} << chunk_shift) - 1)];
+        }
+    };
+
+public:
+    // Walks occupied buckets in index order. Elements are const, since a bucket may be shared with a view.
+    class const_iterator final {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = difference_type;
+        using value_type = const cow_hash_table::value_type;
+        using pointer = value_type*;
+        using reference = value_type&;
+
+        const_iterator(const storage* buckets, size_type index) : m_storage{buckets}, m_index{index} {
+
+        }
+
+        auto operator*() const noexcept -> reference {
+            return m_storage->at(m_index).value;
+        }
+
+        auto operator->() const noexcept -> pointer {
+            return &m_storage->at(m_index).value;
+        }
+
+        auto operator++() noexcept -> const_iterator& {
+            m_index = next_occupied(*m_storage, m_index + 1);
+            return *this;
+        }
+
+        auto operator++(int) noexcept -> const_iterator {
+            auto temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        friend auto operator==(const const_iterator& a, const const_iterator& b) noexcept -> bool {
+            return a.m_storage == b.m_storage && a.m_index == b.m_index;
+        }
+
+        friend auto operator!=(const const_iterator& a, const const_iterator& b) noexcept -> bool {
+            return !(a == b);
+        }
+
+    private:
+        const storage* m_storage;
+        size_type m_index;
+    };
+
+    // A read-only copy of the table as it was when view() was called.
+    class view final {
+    public:
+        auto find(const key_type& key) const noexcept -> const_iterator {
+            const auto index = cow_hash_table::find_index(m_storage, m_key_equal, key, m_hasher(key));
+            return {&m_storage, index.value_or(m_storage.capacity)};
+        }
+
+        auto contains(const key_type& key) const noexcept -> bool {
+            return cow_hash_table::find_index(m_storage, m_key_equal, key, m_hasher(key)).has_value();
+        }
+
+        auto size() const noexcept -> size_type {
+            return m_size;
+        }
+
+        auto begin() const noexcept -> const_iterator {
+            return {&m_storage, next_occupied(m_storage, 0)};
+        }
+
+        auto end() const noexcept -> const_iterator {
+            return {&m_storage, m_storage.capacity};
+        }
+
+    private:
+        friend class cow_hash_table;
+
+        view(const storage& buckets, size_type size, const hasher& hash, const key_equal& equal)
+            : m_storage{buckets}
+            , m_size{size}
+            , m_hasher{hash}
+            , m_key_equal{equal} {
+
+        }
+
+        storage m_storage;
+        size_type m_size;
+        hasher m_hasher;
+        key_equal m_key_equal;
+    };
+
+    cow_hash_table() : m_storage{s_initial_capacity} {
+
+    }
+
+    // Return an existing entry equal to value's key, with false, rather than replacing it.
+    auto insert(value_type&& value) noexcept -> std::pair<const_iterator, bool> {
+        const auto hash = m_hasher(value.first);
+        if (const auto index = find_index(m_storage, m_key_equal, value.first, hash)) {
+            return {iterator_at(*index), false};
+        }
+
+        return insert_bucket({
+            .value = std::move(value),
+            .hash = hash,
+        });
+    }
+
+    // Passes the mapped value of the entry equal to key to update, copying its chunk first if it is shared, or
+    // inserts make() if there is none.
+    template<std::invocable Make, typename Update>
+        requires std::convertible_to<std::invoke_result_t<Make&>, value_type> && std::invocable<Update&, mapped_type&>
+    auto upsert(const key_type& key, Make make, Update update) noexcept -> std::pair<const_iterator, bool> {
+        const auto hash = m_hasher(key);
+        if (const auto index = find_index(m_storage, m_key_equal, key, hash)) {
+            update(writable(*index).value.second);
+            return {iterator_at(*index), false};
+        }
+
+        return insert_bucket({
+            .value = make(),
+            .hash = hash,
+        });
+    }
+
+    auto find(const key_type& key) const noexcept -> const_iterator {
+        const auto index = find_index(m_storage, m_key_equal, key, m_hasher(key));
+        return iterator_at(index.value_or(capacity()));
+    }
+
+    auto contains(const key_type& key) const noexcept -> bool {
+        return find_index(m_storage, m_key_equal, key, m_hasher(key)).has_value();
+    }
+
+    auto remove(const key_type& key) noexcept -> bool {
+        if (const auto index = find_index(m_storage, m_key_equal, key, m_hasher(key))) {
+            remove_at(*index);
+            return true;
+        }
+
+        return false;
+    }
+
+    // Sweeps from just after an empty bucket so that no entry is shifted past the sweep or offered twice. Chunks are
+    // only copied where an entry is removed.
+    template<typename Predicate> requires std::predicate<Predicate&, const_reference>
+    auto erase_if(Predicate predicate) noexcept -> size_type {
+        const auto old_size = m_size;
+        auto start = size_type{0};
+        while (m_storage.at(start).distance != 0) {
+            start++;
+        }
+
+        for (size_type offset = 1; offset < capacity(); ) {
+            const auto index = (start + offset) & (capacity() - 1);
+            const auto& entry = m_storage.at(index);
+            if (entry.distance != 0 && predicate(entry.value)) {
+                remove_at(index);
+            } else {
+                offset++;
+            }
+        }
+
+        return old_size - m_size;
+    }
+
+    auto reserve(size_type count) noexcept -> void {
+        auto new_capacity = capacity();
+        while (static_cast<float>(count) / static_cast<float>(new_capacity) >= s_grow_factor) {
+            new_capacity *= 2;
+        }
+
+        if (new_capacity != capacity()) {
+            rehash(new_capacity);
+        }
+    }
+
+    // Empties chunks this table owns in place and swaps shared ones for fresh chunks, leaving views untouched.
+    auto clear() noexcept -> void {
+        for (auto& ref : m_storage.chunks) {
+            if (!ref.unique()) {
+                ref = chunk_ref{new chunk(ref->buckets.size())};
+                continue;
+            }
+
+            for (auto& entry : ref->buckets) {
+                if (entry.distance != 0) {
+                    entry = {};
+                }
+            }
+        }
+        m_size = 0;
+    }
+
+    // O(chunks): copies the chunk pointers and nothing else.
+    auto snapshot() const noexcept -> view {
+        return {m_storage, m_size, m_hasher, m_key_equal};
+    }
+
+    // How many chunks are shared with a view or copy, and so would be copied by the next write to them.
+    auto shared_chunks() const noexcept -> size_type {
+        return static_cast<size_type>(std::count_if(m_storage.chunks.begin(), m_storage.chunks.end(),
+            [](const chunk_ref& ref) { return !ref.unique(); }));
+    }
+
+    auto empty() const noexcept -> bool {
+        return size() == 0;
+    }
+
+    auto capacity() const noexcept -> size_type {
+        return m_storage.capacity;
+    }
+
+    auto size() const noexcept -> size_type {
+        return m_size;
+    }
+
+    auto begin() const noexcept -> const_iterator {
+        return iterator_at(next_occupied(m_storage, 0));
+    }
+
+    auto end() const noexcept -> const_iterator {
+        return iterator_at(capacity());
+    }
+
+private:
+    static auto home_index(const storage& buckets, hash_type hash) noexcept -> size_type {
+        if constexpr (concepts::avalanching_hash<hasher>) {
+            return hash & (buckets.capacity - 1);
+        }
+        return mix_hash(hash) & (buckets.capacity - 1);
+    }
+
+    static auto find_index(const storage& buckets, const key_equal& equal, const key_type& key, hash_type hash) noexcept
+        -> std::optional<size_type> {
+        auto index = home_index(buckets, hash);
+        auto distance = size_type{1};
+
+        while (buckets.at(index).distance >= distance) {
+            const auto& entry = buckets.at(index);
+            if (entry.hash == hash && equal(entry.value.first, key)) {
+                return index;
+            }
+            index = (index + 1) & (buckets.capacity - 1);
+            distance++;
+        }
+
+        return std::nullopt;
+    }
+
+    static auto next_occupied(const storage& buckets, size_type index) noexcept -> size_type {
+        while (index < buckets.capacity && buckets.at(index).distance == 0) {
+            index++;
+        }
+        return index;
+    }
+
+    auto iterator_at(size_type index) const noexcept -> const_iterator {
+        return {&m_storage, index};
+    }
+
+    auto next_index(size_type index) const noexcept -> size_type {
+        return (index + 1) & (capacity() - 1);
+    }
+
+    // Returns the bucket at index for writing, first giving this table its own copy of the chunk if it is shared.
+    static auto writable(storage& buckets, size_type index) noexcept -> bucket& {
+        auto& ref = buckets.chunks[index >> buckets.chunk_shift];
+        if (!ref.unique()) {
+            ref = chunk_ref{new chunk(*ref)};
+        }
+        return ref->buckets[index & ((size_type{1} << buckets.chunk_shift) - 1)];
+    }
+
+    auto writable(size_type index) noexcept -> bucket& {
+        return writable(m_storage, index);
+    }
+
+    auto insert_bucket(bucket&& entry) noexcept -> std::pair<const_iterator, bool> {
+        if (static_cast<float>(m_size + 1) / static_cast<float>(capacity()) > s_grow_factor) {
+            rehash(capacity() * 2);
+        }
+
+        const auto index = place(m_storage, std::move(entry));
+        m_size++;
+        return {iterator_at(index), true};
+    }
+
+    // Robin Hood placement. Only buckets that change are written, so a probe over a shared chunk leaves it shared.
+    static auto place(storage& buckets, bucket&& entry) noexcept -> size_type {
+        auto index = home_index(buckets, entry.hash);
+        auto position = std::optional<size_type>{};
+        entry.distance = 1;
+
+        while (buckets.at(index).distance != 0) {
+            if (entry.distance > buckets.at(index).distance) {
+                std::swap(entry, writable(buckets, index));
+                if (!position) {
+                    position = index;
+                }
+            }
+            entry.distance++;
+            index = (index + 1) & (buckets.capacity - 1);
+        }
+
+        writable(buckets, index) = std::move(entry);
+        return position.value_or(index);
+    }
+
+    auto remove_at(size_type index) noexcept -> void {
+        auto next = next_index(index);
+        while (m_storage.at(next).distance > 1) {
+            auto& destination = writable(index);
+            destination = std::move(writable(next));
+            destination.distance--;
+            index = next;
+            next = next_index(next);
+        }
+
+        writable(index) = {};
+        m_size--;
+    }
+
+    // Entries are moved out of chunks this table owns and copied out of shared ones.
+    auto rehash(size_type new_capacity) noexcept -> void {
+        storage buckets{new_capacity};
+        for (auto& ref : m_storage.chunks) {
+            const auto owned = ref.unique();
+            for (auto& entry : ref->buckets) {
+                if (entry.distance != 0) {
+                    place(buckets, owned ? std::move(entry) : bucket{entry});
+                }
+            }
+        }
+
+        m_storage = std::move(buckets);
+    }
+
+    static constexpr size_type s_initial_capacity = 8;
+    static constexpr size_type s_chunk_size = 1024;
+    static constexpr float s_grow_factor = 0.75f;
+
+    storage m_storage;
+    size_type m_size{0};
+
+    hasher m_hasher;
+    key_equal m_key_equal;
+};
+} // namespace rjh::detail
+
+#endif // #ifndef RJH_COW_HASH_TABLE_HPP
@@ -0,0 +1,173 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RJH_HASH_KERNELS_HPP
+#define RJH_HASH_KERNELS_HPP
+
+#include "hash_mix.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace rjh::detail {
+static_assert(sizeof(std::size_t) == sizeof(std::uint64_t), "hash kernels store 64-bit lanes as std::size_t");
+
+// mix_hash over several 64-bit lanes at once. Building with -mavx2 mixes four lanes per step, and anything else falls
+// back to one. Both produce the same values as mix_hash. There is no SSE4.1 version: without a 64-bit multiply, two
+// lanes cost six 32-bit products and lose to two scalar multiplies.
+#if defined(__AVX2__)
+struct hash_lanes {
+    static constexpr std::size_t width = 4;
+
+    __m256i value;
+
+    static auto broadcast(std::uint64_t word) noexcept -> hash_lanes {
+        return {_mm256_set1_epi64x(static_cast<long long>(word))};
+    }
+
+    template<typename Word>
+    static auto load(const Word* words) noexcept -> hash_lanes {
+        if constexpr (sizeof(Word) == 8) {
+            return {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(words))};
+        } else {
+            return {_mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(words)))};
+        }
+    }
+
+    auto store(std::size_t* out) const noexcept -> void {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), value);
+    }
+
+    auto operator^(hash_lanes other) const noexcept -> hash_lanes {
+        return {_mm256_xor_si256(value, other.value)};
+    }
+
+    auto mix() const noexcept -> hash_lanes {
+        auto x = value;
+        x = _mm256_xor_si256(x, _mm256_srli_epi64(x, 33));
+        x = multiply(x, 0xff51afd7ed558ccdull);
+        x = _mm256_xor_si256(x, _mm256_srli_epi64(x, 33));
+        x = multiply(x, 0xc4ceb9fe1a85ec53ull);
+        x = _mm256_xor_si256(x, _mm256_srli_epi64(x, 33));
+        return {x};
+    }
+
+private:
+    // AVX2 has no 64-bit multiply, so the low 64 bits of x * factor are built from three 32x32 products.
+    static auto multiply(__m256i x, std::uint64_t factor) noexcept -> __m256i {
+        const auto low = _mm256_set1_epi64x(static_cast<long long>(factor & 0xffffffffull));
+        const auto high = _mm256_set1_epi64x(static_cast<long long>(factor >> 32));
+        const auto cross = _mm256_add_epi64(
+            _mm256_mul_epu32(_mm256_srli_epi64(x, 32), low),
+            _mm256_mul_epu32(x, high)
+        );
+        return _mm256_add_epi64(_mm256_mul_epu32(x, low), _mm256_slli_epi64(cross, 32));
+    }
+};
+#else
+struct hash_lanes {
+    static constexpr std::size_t width = 1;
+
+    std::uint64_t value;
+
+    static auto broadcast(std::uint64_t word) noexcept -> hash_lanes {
+        return {word};
+    }
+
+    template<typename Word>
+    static auto load(const Word* words) noexcept -> hash_lanes {
+        return {*words};
+    }
+
+    auto store(std::size_t* out) const noexcept -> void {
+        *out = value;
+    }
+
+    auto operator^(hash_lanes other) const noexcept -> hash_lanes {
+        return {value ^ other.value};
+    }
+
+    auto mix() const noexcept -> hash_lanes {
+        return {mix_hash(value)};
+    }
+};
+#endif
+
+// Writes mix_hash of each of count unsigned 32 or 64-bit words to out.
+template<typename Word>
+auto mix_words(const Word* words, std::size_t* out, std::size_t count) noexcept -> void {
+    auto i = std::size_t{0};
+    if constexpr (hash_lanes::width > 1) {
+        for (; i + hash_lanes::width <= count; i += hash_lanes::width) {
+            hash_lanes::load(words + i).mix().store(out + i);
+        }
+    }
+
+    for (; i < count; i++) {
+        out[i] = mix_hash(words[i]);
+    }
+}
+
+constexpr auto bytes_seed(std::size_t size) noexcept -> std::uint64_t {
+    return size * 0x9e3779b97f4a7c15ull;
+}
+
+// Reads the 8-byte word at offset, zero padding past the end of the key.
+template<std::size_t Size>
+auto load_word(const std::byte* key, std::size_t offset) noexcept -> std::uint64_t {
+    auto word = std::uint64_t{0};
+    std::memcpy(&word, key + offset, std::min<std::size_t>(8, Size - offset));
+    return word;
+}
+
+// Hashes a Size-byte key by folding each of its 8-byte words into the running state with mix_hash.
+template<std::size_t Size>
+auto hash_bytes(const std::byte* key) noexcept -> std::size_t {
+    auto state = bytes_seed(Size);
+    for (std::size_t offset = 0; offset < Size; offset += 8) {
+        state = mix_hash(state ^ load_word<Size>(key, offset));
+    }
+    return state;
+}
+
+// hash_bytes over count keys laid out Size bytes apart, folding one word of several keys per step.
+template<std::size_t Size>
+auto hash_bytes_batch(const std::byte* keys, std::size_t* out, std::size_t count) noexcept -> void {
+    auto i = std::size_t{0};
+    for (; i + hash_lanes::width <= count; i += hash_lanes::width) {
+        auto state = hash_lanes::broadcast(bytes_seed(Size));
+        for (std::size_t offset = 0; offset < Size; offset += 8) {
+            std::uint64_t words[hash_lanes::width];
+            for (std::size_t lane = 0; lane < hash_lanes::width; lane++) {
+                words[lane] = load_word<Size>(keys + (i + lane) * Size, offset);
+            }
+            state = (state ^ hash_lanes::load(words)).mix();
+        }
+        state.store(out + i);
+    }
+
+    for (; i < count; i++) {
+        out[i] = hash_bytes<Size>(keys + i * Size);
+    }
+}
+} // namespace rjh::detail
+
+#endif // #ifndef RJH_HASH_KERNELS_HPP
@@ -17,20 +17,32 @@
 #define RJH_HASH_TABLE_HPP
 
 #include "../concepts.hpp"
+#include "../hash.hpp"
+#include "hash_mix.hpp"
 
 #include <algorithm>
+#include <bit>
 #include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iterator>
 #include <optional>
+#include <span>
+#include <utility>
 #include <vector>
 
 namespace rjh::detail {
+// When Multi is true the table accepts duplicate keys and keeps equal keys in adjacent probe positions.
+// When Generational is true, clear() leaves buckets untouched and bumps the table's generation instead. A bucket is
+// occupied only while its tag matches the current generation, so stale entries read as empty and are overwritten by
+// later inserts. Their keys are destroyed then, or when the generation wraps and every bucket is reset.
 template<
     typename Key,
-    concepts::hash_function_object<Key> Hash = std::hash<Key>,
-    concepts::key_equal_function_object<Key> KeyEqual = std::equal_to<Key>
+    concepts::hash_function_object<Key> Hash = rjh::hash<Key>,
+    concepts::key_equal_function_object<Key> KeyEqual = std::equal_to<Key>,
+    bool Multi = false,
+    bool Generational = false
 >
 class hash_table final {
 public:
@@ -46,10 +58,14 @@ public:
     struct bucket {
         value_type key{};
         hash_type hash{};
-        bool occupied{false};
+        // Equal to the table's generation while occupied, 0 once emptied.
+        std::uint8_t tag{0};
         size_type distance{0};
     };
 
+    using word_type = std::uint64_t;
+
+    // Walks occupied buckets using the table's occupancy bitmap, skipping a whole word of empty buckets at a time.
     template<typename T>
     class raw_iterator final {
     public:
@@ -59,51 +75,147 @@ public:
         using pointer = value_type*;
         using reference = value_type&;
 
-        raw_iterator(pointer ptr, pointer end)
-            : m_pointer{ptr}
-            , m_end{end} {
+        raw_iterator(pointer buckets, const word_type* occupancy, size_type index, size_type capacity)
+            : m_buckets{buckets}
+            , m_occupancy{occupancy}
+            , m_index{index}
+            , m_capacity{capacity} {
 
         }
 
         auto operator*() const noexcept -> reference {
-            return *m_pointer;
+            return m_buckets[m_index];
         }
 
         auto operator->() const noexcept -> pointer {
-            return m_pointer;
+            return m_buckets + m_index;
         }
 
         auto operator++() noexcept -> raw_iterator& {
-            do {
-                m_pointer++;
-            } while (m_pointer != m_end && !m_pointer->occupied);
+            m_index = next_occupied(m_occupancy, m_index + 1, m_capacity);
             return *this;
         }
 
         auto operator++(int) noexcept -> raw_iterator {
             auto temp = *this;
-            do {
-                ++(*this);
-            } while (m_pointer != m_end && !m_pointer->occupied);
+            ++(*this);
             return temp;
         }
 
         friend auto operator==(const raw_iterator& a, const raw_iterator& b) noexcept -> bool {
-            return a.m_pointer == b.m_pointer;
+            return a.m_buckets == b.m_buckets && a.m_index == b.m_index;
         }
 
         friend auto operator!=(const raw_iterator& a, const raw_iterator& b) noexcept -> bool {
-            return a.m_pointer != b.m_pointer;
+            return !(a == b);
         }
 
     private:
-        pointer m_pointer, m_end;
+        pointer m_buckets;
+        const word_type* m_occupancy;
+        size_type m_index, m_capacity;
     };
 
     using iterator = raw_iterator<bucket>;
     using const_iterator = raw_iterator<const bucket>;
 
-    hash_table() : m_size{0}, m_buckets{s_initial_capacity} {
+    // Walks a run of adjacent buckets in probe order, wrapping around the end of the bucket array.
+    template<typename T>
+    class raw_local_iterator final {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = difference_type;
+        using value_type = T;
+        using pointer = value_type*;
+        using reference = value_type&;
+
+        raw_local_iterator(pointer buckets, size_type index, size_type capacity)
+            : m_buckets{buckets}
+            , m_index{index}
+            , m_capacity{capacity} {
+
+        }
+
+        auto operator*() const noexcept -> reference {
+            return m_buckets[m_index];
+        }
+
+        auto operator->() const noexcept -> pointer {
+            return m_buckets + m_index;
+        }
+
+        auto operator++() noexcept -> raw_local_iterator& {
+            if (++m_index == m_capacity) {
+                m_index = 0;
+            }
+            return *this;
+        }
+
+        auto operator++(int) noexcept -> raw_local_iterator {
+            auto temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        friend auto operator==(const raw_local_iterator& a, const raw_local_iterator& b) noexcept -> bool {
+            return a.m_buckets == b.m_buckets && a.m_index == b.m_index;
+        }
+
+        friend auto operator!=(const raw_local_iterator& a, const raw_local_iterator& b) noexcept -> bool {
+            return !(a == b);
+        }
+
+    private:
+        pointer m_buckets;
+        size_type m_index, m_capacity;
+    };
+
+    using local_iterator = raw_local_iterator<bucket>;
+    using const_local_iterator = raw_local_iterator<const bucket>;
+
+    // Owns an element removed from a table along with its cached hash, so it can be inserted into another table of
+    // the same type without being rehashed.
+    class node_handle final {
+    public:
+        node_handle() = default;
+
+        [[nodiscard]] auto empty() const noexcept -> bool {
+            return !m_key.has_value();
+        }
+
+        explicit operator bool() const noexcept {
+            return !empty();
+        }
+
+        [[nodiscard]] auto key() noexcept -> reference {
+            return *m_key;
+        }
+
+        [[nodiscard]] auto key() const noexcept -> const_reference {
+            return *m_key;
+        }
+
+        [[nodiscard]] auto hash() const noexcept -> hash_type {
+            return m_hash;
+        }
+
+    private:
+        friend class hash_table;
+
+        node_handle(value_type&& key, hash_type hash)
+            : m_key{std::move(key)}
+            , m_hash{hash} {
+
+        }
+
+        std::optional<value_type> m_key;
+        hash_type m_hash{};
+    };
+
+    hash_table()
+        : m_size{0}
+        , m_buckets{s_initial_capacity}
+        , m_occupancy(word_count(s_initial_capacity)) {
 
     }
 
@@ -115,49 +227,94 @@ public:
     hash_table& operator=(hash_table&&) = default;
 
     auto insert(const_reference key) noexcept -> std::pair<iterator, bool> {
-        if (find(key) != end()) {
+        if (!Multi && find(key) != end()) {
             return {end(), false};
         }
 
         const auto hash = m_hasher(key);
-        return insert({
+        return insert_bucket({
             .key = key,
             .hash = hash,
-            .occupied = true,
         });
     }
 
     auto insert(value_type&& key) noexcept -> std::pair<iterator, bool> {
-        if (find(key) != end()) {
+        if (!Multi && find(key) != end()) {
             return {end(), false};
         }
 
         const auto hash = m_hasher(key);
-        return insert({
+        return insert_bucket({
             .key = std::move(key),
             .hash = hash,
-            .occupied = true,
         });
     }
 
     template<typename K> requires std::constructible_from<value_type, K&&>
     auto insert(K&& key) noexcept -> std::pair<iterator, bool> {
-        return insert(std::forward<K>(key));
+        return insert(value_type(std::forward<K>(key)));
+    }
+
+    // Leaves node untouched if it is empty or its key is already present.
+    auto insert(node_handle&& node) noexcept -> std::pair<iterator, bool> {
+        if (node.empty()) {
+            return {end(), false};
+        }
+
+        if constexpr (!Multi) {
+            if (const auto index = find_index(*node.m_key, node.m_hash)) {
+                return {iterator_at(*index), false};
+            }
+        }
+
+        auto result = insert_bucket({
+            .key = std::move(*node.m_key),
+            .hash = node.m_hash,
+        });
+        node.m_key.reset();
+        return result;
+    }
+
+    // Returns the entry equal to key, or inserts the value returned by make under key's hash. make is only called
+    // when key is absent, so callers can defer building or copying the stored key until it is needed.
+    template<typename K, std::invocable Make> requires (!Multi) && std::convertible_to<std::invoke_result_t<Make&>, value_type>
+    auto find_or_insert(const K& key, Make make) noexcept -> std::pair<iterator, bool> {
+        const auto hash = m_hasher(key);
+        if (const auto index = find_index(key, hash)) {
+            return {iterator_at(*index), false};
+        }
+
+        return insert_bucket({
+            .key = make(),
+            .hash = hash,
+        });
+    }
+
+    auto extract(const_reference key) noexcept -> node_handle {
+        const auto hash = m_hasher(key);
+        const auto index = find_index(key, hash);
+        return index ? extract_at(*index) : node_handle{};
+    }
+
+    template<typename K> requires concepts::is_transparent<hasher> && concepts::is_transparent<key_equal>
+    auto extract(const K& key) noexcept -> node_handle {
+        const auto hash = m_hasher(key);
+        const auto index = find_index(key, hash);
+        return index ? extract_at(*index) : node_handle{};
     }
 
     auto find(const_reference key) noexcept -> iterator {
         const auto hash = m_hasher(key);
-        auto index = hash % capacity();
+        auto index = home_index(hash);
+        auto distance = size_type{0};
 
-        while (m_buckets[index].occupied) {
+        while (is_occupied(m_buckets[index]) && m_buckets[index].distance >= distance) {
             const auto& entry = m_buckets[index];
-            if (m_key_equal(entry.key, key)) {
-                return iterator{
-                    m_buckets.begin().operator->() + index,
-                    m_buckets.end().operator->()
-                };
+            if (entry.hash == hash && m_key_equal(entry.key, key)) {
+                return iterator_at(index);
             }
-            index = (index + 1) % capacity();
+            index = next_index(index);
+            distance++;
         }
 
         return end();
@@ -165,17 +322,16 @@ public:
 
     auto find(const_reference key) const noexcept -> const_iterator {
         const auto hash = m_hasher(key);
-        auto index = hash % capacity();
+        auto index = home_index(hash);
+        auto distance = size_type{0};
 
-        while (m_buckets[index].occupied) {
+        while (is_occupied(m_buckets[index]) && m_buckets[index].distance >= distance) {
             const auto& entry = m_buckets[index];
-            if (m_key_equal(entry.key, key.key)) {
-                return const_iterator{
-                    m_buckets.begin().operator->() + index,
-                    m_buckets.end().operator->()
-                };
+            if (entry.hash == hash && m_key_equal(entry.key, key)) {
+                return iterator_at(index);
             }
-            index = (index + 1) % capacity();
+            index = next_index(index);
+            distance++;
         }
 
         return end();
@@ -184,17 +340,16 @@ public:
     template<typename K> requires concepts::is_transparent<hasher> && concepts::is_transparent<key_equal>
     auto find(const K& key) noexcept -> iterator {
         const auto hash = m_hasher(key);
-        auto index = hash % capacity();
+        auto index = home_index(hash);
+        auto distance = size_type{0};
 
-        while (m_buckets[index].occupied) {
+        while (is_occupied(m_buckets[index]) && m_buckets[index].distance >= distance) {
             const auto& entry = m_buckets[index];
-            if (m_key_equal(entry.key, key)) {
-                return iterator{
-                    m_buckets.begin().operator->() + index,
-                    m_buckets.end().operator->(),
-                };
+            if (entry.hash == hash && m_key_equal(entry.key, key)) {
+                return iterator_at(index);
             }
-            index = (index + 1) % capacity();
+            index = next_index(index);
+            distance++;
         }
 
         return end();
@@ -203,17 +358,16 @@ public:
     template<typename K> requires concepts::is_transparent<hasher> && concepts::is_transparent<key_equal>
     auto find(const K& key) const noexcept -> const_iterator {
         const auto hash = m_hasher(key);
-        auto index = hash % capacity();
+        auto index = home_index(hash);
+        auto distance = size_type{0};
 
-        while (m_buckets[index].occupied) {
+        while (is_occupied(m_buckets[index]) && m_buckets[index].distance >= distance) {
             const auto& entry = m_buckets[index];
-            if (m_key_equal(entry.key, key)) {
-                return const_iterator{
-                    m_buckets.begin().operator->() + index,
-                    m_buckets.end().operator->(),
-                };
+            if (entry.hash == hash && m_key_equal(entry.key, key)) {
+                return iterator_at(index);
             }
-            index = (index + 1) % capacity();
+            index = next_index(index);
+            distance++;
         }
 
         return end();
@@ -228,51 +382,389 @@ public:
         return find(key) != end();
     }
 
-    auto remove(const_reference key) noexcept -> bool {
-        auto index = m_hasher(key) % capacity();
+    // Looks key up under a hash the caller already computed with this table's hasher.
+    auto contains(const_reference key, hash_type hash) const noexcept -> bool {
+        return find_index(key, hash).has_value();
+    }
 
-        while (m_buckets[index].occupied) {
-            auto& entry = m_buckets[index];
-            if (m_key_equal(entry.key, key)) {
-                entry = {};
-                index = (index + 1) % capacity();
-                while (m_buckets[index].occupied && m_buckets[index].distance > 0) {
-                    std::swap(entry, m_buckets[index]);
-                    index = (index + 1) % capacity();
+    // Inserts each key in turn and returns how many were inserted. Keys are hashed a batch at a time, through the
+    // hasher's hash_batch when it has one, and the home buckets of a batch are prefetched before any are probed.
+    auto insert_bulk(std::span<const value_type> keys) noexcept -> size_type {
+        const auto old_size = m_size;
+        hash_type hashes[s_prefetch_distance];
+
+        for (size_type batch = 0; batch < keys.size(); batch += s_prefetch_distance) {
+            const auto chunk = keys.subspan(batch, std::min(s_prefetch_distance, keys.size() - batch));
+            hash_keys(chunk, hashes);
+
+            for (size_type i = 0; i < chunk.size(); i++) {
+                prefetch(hashes[i]);
+            }
+
+            for (size_type i = 0; i < chunk.size(); i++) {
+                if (Multi || !find_index(chunk[i], hashes[i])) {
+                    insert_bucket({
+                        .key = chunk[i],
+                        .hash = hashes[i],
+                    });
                 }
-                m_size--;
-                return true;
             }
-            index = (index + 1) % capacity();
         }
 
-        return false;
+        return m_size - old_size;
+    }
+
+    // For each i, passes the entry equal to keys[i] to update(entry, i), or inserts make(i) if there is none, so a row
+    // of a columnar batch is hashed once whether or not its key is new. Hashes and prefetches in batches like
+    // insert_bulk.
+    template<typename K, typename Make, typename Update>
+        requires (!Multi)
+            && std::convertible_to<std::invoke_result_t<Make&, size_type>, value_type>
+            && std::invocable<Update&, reference, size_type>
+    auto upsert_bulk(std::span<const K> keys, Make make, Update update) noexcept -> void {
+        hash_type hashes[s_prefetch_distance];
+
+        for (size_type batch = 0; batch < keys.size(); batch += s_prefetch_distance) {
+            const auto chunk = keys.subspan(batch, std::min(s_prefetch_distance, keys.size() - batch));
+            hash_keys(chunk, hashes);
+
+            for (size_type i = 0; i < chunk.size(); i++) {
+                prefetch(hashes[i]);
+            }
+
+            for (size_type i = 0; i < chunk.size(); i++) {
+                if (const auto index = find_index(chunk[i], hashes[i])) {
+                    update(m_buckets[*index].key, batch + i);
+                } else {
+                    insert_bucket({
+                        .key = make(batch + i),
+                        .hash = hashes[i],
+                    });
+                }
+            }
+        }
+    }
+
+    // Sets found[i] to whether keys[i] is in the table and returns how many were. found must be at least as long as
+    // keys. Hashes and prefetches in batches like insert_bulk.
+    auto contains_bulk(std::span<const value_type> keys, std::span<bool> found) const noexcept -> size_type {
+        auto count = size_type{0};
+        hash_type hashes[s_prefetch_distance];
+
+        for (size_type batch = 0; batch < keys.size(); batch += s_prefetch_distance) {
+            const auto chunk = keys.subspan(batch, std::min(s_prefetch_distance, keys.size() - batch));
+            hash_keys(chunk, hashes);
+
+            for (size_type i = 0; i < chunk.size(); i++) {
+                prefetch(hashes[i]);
+            }
+
+            for (size_type i = 0; i < chunk.size(); i++) {
+                found[batch + i] = find_index(chunk[i], hashes[i]).has_value();
+                count += found[batch + i];
+            }
+        }
+
+        return count;
+    }
+
+    auto remove(const_reference key) noexcept -> bool {
+        const auto index = find_index(key, m_hasher(key));
+        if (index) {
+            remove_at(*index);
+        }
+
+        return index.has_value();
     }
 
     template<typename K> requires concepts::is_transparent<hasher> && concepts::is_transparent<key_equal>
     auto remove(K&& key) noexcept -> bool {
-        auto index = m_hasher(key) % capacity();
+        const auto index = find_index(key, m_hasher(key));
+        if (index) {
+            remove_at(*index);
+        }
 
-        while (m_buckets[index].occupied) {
-            auto& entry = m_buckets[index];
-            if (m_key_equal(entry.key, key)) {
-                entry = {};
-                index = (index + 1) % capacity();
-                while (m_buckets[index].occupied && m_buckets[index].distance > 0) {
-                    std::swap(entry, m_buckets[index]);
-                    index = (index + 1) % capacity();
-                }
-                m_size--;
+        return index.has_value();
+    }
+
+    auto count(const_reference key) const noexcept -> size_type {
+        return find_group(key, m_hasher(key)).second;
+    }
+
+    template<typename K> requires concepts::is_transparent<hasher> && concepts::is_transparent<key_equal>
+    auto count(const K& key) const noexcept -> size_type {
+        return find_group(key, m_hasher(key)).second;
+    }
+
+    auto equal_range(const_reference key) noexcept -> std::pair<local_iterator, local_iterator> {
+        return local_range(find_group(key, m_hasher(key)));
+    }
+
+    auto equal_range(const_reference key) const noexcept -> std::pair<const_local_iterator, const_local_iterator> {
+        return local_range(find_group(key, m_hasher(key)));
+    }
+
+    template<typename K> requires concepts::is_transparent<hasher> && concepts::is_transparent<key_equal>
+    auto equal_range(const K& key) noexcept -> std::pair<local_iterator, local_iterator> {
+        return local_range(find_group(key, m_hasher(key)));
+    }
+
+    template<typename K> requires concepts::is_transparent<hasher> && concepts::is_transparent<key_equal>
+    auto equal_range(const K& key) const noexcept -> std::pair<const_local_iterator, const_local_iterator> {
+        return local_range(find_group(key, m_hasher(key)));
+    }
+
+    auto remove_all(const_reference key) noexcept -> size_type {
+        const auto [first, count] = find_group(key, m_hasher(key));
+        remove_run(first, count);
+        return count;
+    }
+
+    template<typename K> requires concepts::is_transparent<hasher> && concepts::is_transparent<key_equal>
+    auto remove_all(const K& key) noexcept -> size_type {
+        const auto [first, count] = find_group(key, m_hasher(key));
+        remove_run(first, count);
+        return count;
+    }
+
+    template<typename Predicate> requires std::predicate<Predicate&, const_reference>
+    auto erase_if(Predicate predicate, bool shrink = false) noexcept -> size_type {
+        const auto removed = compact([&predicate](bucket& entry, size_type) {
+            return predicate(std::as_const(entry.key));
+        });
+
+        if (shrink) {
+            shrink_to_fit();
+        }
+
+        return removed;
+    }
+
+    template<typename Predicate> requires std::predicate<Predicate&, const_reference>
+    auto retain(Predicate predicate, bool shrink = false) noexcept -> size_type {
+        return erase_if([&predicate](const_reference key) { return !predicate(key); }, shrink);
+    }
+
+    // Removes the first entry with the given cached hash whose key satisfies predicate, without rehashing anything.
+    template<typename Predicate> requires std::predicate<Predicate&, const_reference>
+    auto remove_with_hash(hash_type hash, Predicate predicate) noexcept -> bool {
+        auto index = home_index(hash);
+        auto distance = size_type{0};
+
+        while (is_occupied(m_buckets[index]) && m_buckets[index].distance >= distance) {
+            const auto& entry = m_buckets[index];
+            if (entry.hash == hash && predicate(entry.key)) {
+                remove_at(index);
                 return true;
             }
-            index = (index + 1) % capacity();
+            index = next_index(index);
+            distance++;
         }
 
         return false;
     }
 
+    // Visits buckets in a fixed pseudo-random cycle, advancing hand once per bucket, and removes the first entry for
+    // which predicate returns true. Sweeping in bucket order would concentrate removals just behind the hand while
+    // inserts pile up ahead of it into long clusters. The stride is odd and capacity is a power of two, so every bucket
+    // is visited once per cycle. The predicate may modify the entries it passes over and must eventually accept one.
+    template<typename Predicate> requires std::predicate<Predicate&, reference>
+    auto sweep_remove(size_type& hand, Predicate predicate) noexcept -> bool {
+        if (empty()) {
+            return false;
+        }
+
+        for (; ; hand++) {
+            const auto index = static_cast<size_type>(hand * s_sweep_stride) % capacity();
+            auto& entry = m_buckets[index];
+            if (is_occupied(entry) && predicate(entry.key)) {
+                remove_at(index);
+                return true;
+            }
+        }
+    }
+
+    auto reserve(size_type count) noexcept -> void {
+        auto new_capacity = capacity();
+        while (static_cast<float>(count) / static_cast<float>(new_capacity) >= s_grow_factor) {
+            new_capacity *= 2;
+        }
+
+        if (new_capacity != capacity()) {
+            rehash(new_capacity);
+        }
+    }
+
+    auto shrink_to_fit() noexcept -> void {
+        auto new_capacity = capacity();
+        while (new_capacity > s_initial_capacity
+            && static_cast<float>(size()) / static_cast<float>(new_capacity / 2) < s_grow_factor) {
+            new_capacity /= 2;
+        }
+
+        if (new_capacity != capacity()) {
+            rehash(new_capacity);
+            m_buckets.shrink_to_fit();
+            m_occupancy.shrink_to_fit();
+        }
+    }
+
+    auto merge(hash_table& other) noexcept -> void {
+        if (this == &other || other.empty()) {
+            return;
+        }
+
+        // Nothing to collide with, so adopt the other bucket array wholesale instead of reinserting.
+        if (empty()) {
+            std::swap(m_buckets, other.m_buckets);
+            std::swap(m_occupancy, other.m_occupancy);
+            std::swap(m_generation, other.m_generation);
+            std::swap(m_size, other.m_size);
+            return;
+        }
+
+        other.compact([this, &other](bucket& entry, size_type index) {
+            other.prefetch_ahead(*this, index);
+            if (find_index(entry.key, entry.hash)) {
+                return false;
+            }
+
+            insert_bucket({
+                .key = std::move(entry.key),
+                .hash = entry.hash,
+            });
+            return true;
+        });
+    }
+
+    // Moves every entry of other into this table, like merge, except that an entry whose key is already present is
+    // passed to combine(existing, std::move(entry)) instead of being left behind. other is empty afterwards.
+    template<typename Combine> requires (!Multi) && std::invocable<Combine&, reference, value_type&&>
+    auto merge_with(hash_table& other, Combine combine) noexcept -> void {
+        if (this == &other || other.empty()) {
+            return;
+        }
+
+        if (empty()) {
+            std::swap(m_buckets, other.m_buckets);
+            std::swap(m_occupancy, other.m_occupancy);
+            std::swap(m_generation, other.m_generation);
+            std::swap(m_size, other.m_size);
+            return;
+        }
+
+        other.compact([this, &other, &combine](bucket& entry, size_type index) {
+            other.prefetch_ahead(*this, index);
+            if (const auto existing = find_index(entry.key, entry.hash)) {
+                combine(m_buckets[*existing].key, std::move(entry.key));
+            } else {
+                insert_bucket({
+                    .key = std::move(entry.key),
+                    .hash = entry.hash,
+                });
+            }
+            return true;
+        });
+    }
+
+    auto union_with(const hash_table& other) noexcept -> void {
+        if (this == &other) {
+            return;
+        }
+
+        if (size() < other.size()) {
+            auto result = other;
+            result.merge(*this);
+            *this = std::move(result);
+            return;
+        }
+
+        probe_batched(other, [this](const bucket& entry, std::optional<size_type> index) {
+            if (!index) {
+                insert_bucket({
+                    .key = entry.key,
+                    .hash = entry.hash,
+                });
+            }
+            return true;
+        });
+    }
+
+    auto intersect_with(const hash_table& other) noexcept -> void {
+        if (this == &other) {
+            return;
+        }
+
+        if (size() <= other.size()) {
+            compact([this, &other](bucket& entry, size_type index) {
+                prefetch_ahead(other, index);
+                return !other.find_index(entry.key, entry.hash);
+            });
+            return;
+        }
+
+        hash_table result;
+        probe_batched(other, [&result](const bucket& entry, std::optional<size_type> index) {
+            if (index) {
+                result.insert_bucket({
+                    .key = entry.key,
+                    .hash = entry.hash,
+                });
+            }
+            return true;
+        });
+        *this = std::move(result);
+    }
+
+    auto difference_with(const hash_table& other) noexcept -> void {
+        if (this == &other) {
+            clear();
+            return;
+        }
+
+        if (size() <= other.size()) {
+            compact([this, &other](bucket& entry, size_type index) {
+                prefetch_ahead(other, index);
+                return other.find_index(entry.key, entry.hash).has_value();
+            });
+            return;
+        }
+
+        probe_batched(other, [this](const bucket&, std::optional<size_type> index) {
+            if (index) {
+                remove_at(*index);
+            }
+            return true;
+        });
+    }
+
+    auto is_subset_of(const hash_table& other) const noexcept -> bool {
+        if (size() > other.size()) {
+            return false;
+        }
+
+        return other.probe_batched(*this, [](const bucket&, std::optional<size_type> index) {
+            return index.has_value();
+        });
+    }
+
+    // Only visits occupied buckets, so clearing a sparse table costs in proportion to its size, not its capacity. A
+    // generational table skips even that and only resets the occupancy bitmap.
     auto clear() noexcept -> void {
-        std::fill(m_buckets.begin(), m_buckets.end(), bucket{});
+        if constexpr (Generational) {
+            if (++m_generation == 0) {
+                std::fill(m_buckets.begin(), m_buckets.end(), bucket{});
+                m_generation = 1;
+            }
+        } else {
+            for (auto index = next_occupied(m_occupancy.data(), 0, capacity());
+                index != capacity();
+                index = next_occupied(m_occupancy.data(), index + 1, capacity())) {
+                m_buckets[index] = {};
+            }
+        }
+
+        std::fill(m_occupancy.begin(), m_occupancy.end(), word_type{0});
         m_size = 0;
     }
 
@@ -289,78 +781,379 @@ public:
     }
 
     auto begin() noexcept -> iterator {
-        if (empty()) {
-            return end();
+        return iterator_at(next_occupied(m_occupancy.data(), 0, capacity()));
+    }
+
+    auto begin() const noexcept -> const_iterator {
+        return iterator_at(next_occupied(m_occupancy.data(), 0, capacity()));
+    }
+
+    auto cbegin() const noexcept -> const_iterator {
+        return begin();
+    }
+
+    auto end() noexcept -> iterator {
+        return iterator_at(capacity());
+    }
+
+    auto end() const noexcept -> const_iterator {
+        return iterator_at(capacity());
+    }
+
+    auto cend() const noexcept -> const_iterator {
+        return end();
+    }
+
+private:
+    // Runs remove(entry, index) over every occupied bucket in a single sweep, starting just after an empty bucket so
+    // no cluster wraps past the start. Removed buckets are cleared and each survivor is shifted back as far as its
+    // home bucket allows, which repairs displacement as we go. Buckets ahead of the sweep are never touched.
+    template<typename Remove>
+    auto compact(Remove remove) noexcept -> size_type {
+        const auto cap = capacity();
+        auto start = size_type{0};
+        while (is_occupied(m_buckets[start])) {
+            start++;
         }
 
-        iterator it{
-            m_buckets.begin().operator->(),
-            m_buckets.end().operator->()
-        };
+        const auto old_size = m_size;
+        auto write = size_type{0};
+
+        for (size_type offset = 0; offset < cap - 1; offset++) {
+            const auto index = (start + 1 + offset) % cap;
+            auto& entry = m_buckets[index];
 
-        if (!it->occupied) {
-            it++;
+            if (!is_occupied(entry)) {
+                write = offset + 1;
+                continue;
+            }
+
+            if (remove(entry, index)) {
+                entry = {};
+                mark_empty(index);
+                m_size--;
+                continue;
+            }
+
+            const auto home = offset - entry.distance;
+            const auto target = std::max(home, write);
+            if (target != offset) {
+                const auto destination_index = (start + 1 + target) % cap;
+                auto& destination = m_buckets[destination_index];
+                destination = std::move(entry);
+                destination.distance = target - home;
+                entry = {};
+                mark_occupied(destination_index);
+                mark_empty(index);
+            }
+            write = target + 1;
         }
 
-        return it;
+        return old_size - m_size;
     }
 
-    auto begin() const noexcept -> const_iterator {
-        if (empty()) {
-            return end();
+    // Looks up every occupied bucket of source in this table, prefetching the home buckets of a whole batch before
+    // probing any of them. Stops early if fn returns false.
+    template<typename Fn>
+    auto probe_batched(const hash_table& source, Fn fn) const noexcept -> bool {
+        const auto& buckets = source.m_buckets;
+        for (size_type batch = 0; batch < buckets.size(); batch += s_prefetch_distance) {
+            const auto last = std::min(batch + s_prefetch_distance, buckets.size());
+
+            for (auto i = batch; i < last; i++) {
+                if (source.is_occupied(buckets[i])) {
+                    prefetch(buckets[i].hash);
+                }
+            }
+
+            for (auto i = batch; i < last; i++) {
+                if (source.is_occupied(buckets[i]) && !fn(buckets[i], find_index(buckets[i].key, buckets[i].hash))) {
+                    return false;
+                }
+            }
         }
 
-        const_iterator it{
-            m_buckets.begin().operator->(),
-            m_buckets.end().operator->()
-        };
+        return true;
+    }
 
-        if (!it->occupied) {
-            it++;
+    template<typename K>
+    auto hash_keys(std::span<const K> keys, hash_type* hashes) const noexcept -> void {
+        if constexpr (concepts::batch_hash_function_object<hasher, K>) {
+            m_hasher.hash_batch(keys, std::span{hashes, keys.size()});
+        } else {
+            for (size_type i = 0; i < keys.size(); i++) {
+                hashes[i] = m_hasher(keys[i]);
+            }
         }
+    }
+
+    template<typename K>
+    auto find_index(const K& key, hash_type hash) const noexcept -> std::optional<size_type> {
+        auto index = home_index(hash);
+        auto distance = size_type{0};
 
-        return it;
+        while (is_occupied(m_buckets[index]) && m_buckets[index].distance >= distance) {
+            const auto& entry = m_buckets[index];
+            if (entry.hash == hash && m_key_equal(entry.key, key)) {
+                return index;
+            }
+            index = next_index(index);
+            distance++;
+        }
+
+        return std::nullopt;
     }
 
-    auto cbegin() const noexcept -> const_iterator {
-        return begin();
+    // Returns the index of the first bucket holding key and how many adjacent buckets hold it. Stops as soon as the
+    // probe distance exceeds the distance stored in a bucket, since key would have displaced that entry.
+    template<typename K>
+    auto find_group(const K& key, hash_type hash) const noexcept -> std::pair<size_type, size_type> {
+        auto index = home_index(hash);
+        auto distance = size_type{0};
+
+        while (is_occupied(m_buckets[index]) && m_buckets[index].distance >= distance) {
+            const auto& entry = m_buckets[index];
+            if (entry.hash == hash && m_key_equal(entry.key, key)) {
+                auto count = size_type{1};
+                auto next = next_index(index);
+                while (is_occupied(m_buckets[next])
+                    && m_buckets[next].hash == hash
+                    && m_key_equal(m_buckets[next].key, key)) {
+                    count++;
+                    next = next_index(next);
+                }
+                return {index, count};
+            }
+            index = next_index(index);
+            distance++;
+        }
+
+        return {index, 0};
     }
 
-    auto end() noexcept -> iterator {
-        return iterator{
-            m_buckets.end().operator->(),
-            m_buckets.end().operator->(),
+    auto local_range(std::pair<size_type, size_type> group) noexcept -> std::pair<local_iterator, local_iterator> {
+        const auto [first, count] = group;
+        return {
+            local_iterator{m_buckets.data(), first, capacity()},
+            local_iterator{m_buckets.data(), (first + count) % capacity(), capacity()},
         };
     }
 
-    auto end() const noexcept -> const_iterator {
-        return const_iterator{
-            m_buckets.end().operator->(),
-            m_buckets.end().operator->(),
+    auto local_range(std::pair<size_type, size_type> group) const noexcept
+        -> std::pair<const_local_iterator, const_local_iterator> {
+        const auto [first, count] = group;
+        return {
+            const_local_iterator{m_buckets.data(), first, capacity()},
+            const_local_iterator{m_buckets.data(), (first + count) % capacity(), capacity()},
         };
     }
 
-    auto cend() const noexcept -> const_iterator {
-        return end();
+    // Clears count adjacent buckets starting at first, then shifts the entries that follow back into the gap.
+    auto remove_run(size_type first, size_type count) noexcept -> void {
+        if (count == 0) {
+            return;
+        }
+
+        for (size_type offset = 0; offset < count; offset++) {
+            const auto index = (first + offset) % capacity();
+            m_buckets[index] = {};
+            mark_empty(index);
+        }
+
+        auto write = size_type{0};
+        for (auto offset = count; ; offset++) {
+            const auto index = (first + offset) % capacity();
+            auto& entry = m_buckets[index];
+            if (!is_occupied(entry) || entry.distance == 0) {
+                break;
+            }
+
+            const auto target = entry.distance >= offset - write ? write : offset - entry.distance;
+            const auto destination_index = (first + target) % capacity();
+            auto& destination = m_buckets[destination_index];
+            destination = std::move(entry);
+            destination.distance -= offset - target;
+            entry = {};
+            mark_occupied(destination_index);
+            mark_empty(index);
+            write = target + 1;
+        }
+
+        m_size -= count;
     }
 
-private:
-    auto insert(bucket&& entry) noexcept -> std::pair<iterator, bool> {
+    auto next_index(size_type index) const noexcept -> size_type {
+        return index + 1 == capacity() ? 0 : index + 1;
+    }
+
+    auto home_index(hash_type hash) const noexcept -> size_type {
+        if constexpr (concepts::avalanching_hash<hasher>) {
+            return hash % capacity();
+        }
+        return mix_hash(hash) % capacity();
+    }
+
+    auto prefetch(hash_type hash) const noexcept -> void {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(m_buckets.data() + home_index(hash));
+#else
+        static_cast<void>(hash);
+#endif
+    }
+
+    // Prefetches the bucket in target that the entry s_prefetch_distance slots ahead of index will probe.
+    auto prefetch_ahead(const hash_table& target, size_type index) const noexcept -> void {
+        const auto& ahead = m_buckets[(index + s_prefetch_distance) % capacity()];
+        if (is_occupied(ahead)) {
+            target.prefetch(ahead.hash);
+        }
+    }
+
+    auto extract_at(size_type index) noexcept -> node_handle {
+        auto& entry = m_buckets[index];
+        node_handle node{std::move(entry.key), entry.hash};
+        remove_at(index);
+        return node;
+    }
+
+    auto remove_at(size_type index) noexcept -> void {
+        m_buckets[index] = {};
+        auto next = next_index(index);
+
+        while (is_occupied(m_buckets[next]) && m_buckets[next].distance > 0) {
+            std::swap(m_buckets[index], m_buckets[next]);
+            m_buckets[index].distance--;
+            index = next;
+            next = next_index(next);
+        }
+
+        mark_empty(index);
+        m_size--;
+    }
+
+    auto insert_bucket(bucket&& entry) noexcept -> std::pair<iterator, bool> {
         check_load();
-        auto index = entry.hash % capacity();
+        entry.tag = generation();
+
+        if constexpr (Multi) {
+            return insert_into_group(std::move(entry));
+        }
+
+        auto index = home_index(entry.hash);
+        auto position = std::optional<size_type>{};
 
-        while (m_buckets[index].occupied) {
+        while (is_occupied(m_buckets[index])) {
             auto& old = m_buckets[index];
             if (entry.distance > old.distance) {
                 std::swap(entry, old);
+                if (!position) {
+                    position = index;
+                }
             }
             entry.distance++;
-            index = (index + 1) % capacity();
+            index = next_index(index);
         }
 
         m_buckets[index] = std::move(entry);
+        mark_occupied(index);
         m_size++;
-        return {iterator{m_buckets.data() + index, m_buckets.end().operator->()}, true};
+        return {iterator_at(position.value_or(index)), true};
+    }
+
+    // Places entry after any entries with an equal key, or at its Robin Hood position if there are none, then shifts
+    // every following entry in the cluster forward by one. Shifting rather than swapping on distance keeps every run
+    // of equal keys adjacent.
+    auto insert_into_group(bucket&& entry) noexcept -> std::pair<iterator, bool> {
+        auto index = home_index(entry.hash);
+        auto in_group = false;
+
+        while (is_occupied(m_buckets[index])) {
+            const auto& old = m_buckets[index];
+            const auto equal = old.hash == entry.hash && m_key_equal(old.key, entry.key);
+            if (equal) {
+                in_group = true;
+            } else if (in_group || entry.distance > old.distance) {
+                break;
+            }
+            entry.distance++;
+            index = next_index(index);
+        }
+
+        const auto position = index;
+        shift_in(index, std::move(entry));
+        m_size++;
+        return {iterator_at(position), true};
+    }
+
+    // Moves every entry from index up to the next empty bucket forward by one, then places entry at index.
+    auto shift_in(size_type index, bucket&& entry) noexcept -> void {
+        auto last = index;
+        while (is_occupied(m_buckets[last])) {
+            last = next_index(last);
+        }
+        mark_occupied(last);
+
+        while (last != index) {
+            const auto previous = last == 0 ? capacity() - 1 : last - 1;
+            m_buckets[last] = std::move(m_buckets[previous]);
+            m_buckets[last].distance++;
+            last = previous;
+        }
+
+        m_buckets[index] = std::move(entry);
+    }
+
+    auto generation() const noexcept -> std::uint8_t {
+        if constexpr (Generational) {
+            return m_generation;
+        } else {
+            return 1;
+        }
+    }
+
+    auto is_occupied(const bucket& entry) const noexcept -> bool {
+        return entry.tag == generation();
+    }
+
+    auto iterator_at(size_type index) noexcept -> iterator {
+        return iterator{m_buckets.data(), m_occupancy.data(), index, capacity()};
+    }
+
+    auto iterator_at(size_type index) const noexcept -> const_iterator {
+        return const_iterator{m_buckets.data(), m_occupancy.data(), index, capacity()};
+    }
+
+    auto mark_occupied(size_type index) noexcept -> void {
+        m_occupancy[index / s_word_bits] |= word_type{1} << (index % s_word_bits);
+    }
+
+    auto mark_empty(size_type index) noexcept -> void {
+        m_occupancy[index / s_word_bits] &= ~(word_type{1} << (index % s_word_bits));
+    }
+
+    static constexpr auto word_count(size_type capacity) noexcept -> size_type {
+        return (capacity + s_word_bits - 1) / s_word_bits;
+    }
+
+    // Returns the first occupied index at or after index, or capacity if there is none. Bits past capacity in the
+    // last word are never set, so they cannot produce a false match.
+    static auto next_occupied(const word_type* occupancy, size_type index, size_type capacity) noexcept -> size_type {
+        if (index >= capacity) {
+            return capacity;
+        }
+
+        auto word = index / s_word_bits;
+        auto bits = occupancy[word] & (~word_type{0} << (index % s_word_bits));
+        const auto last = word_count(capacity);
+
+        while (bits == 0) {
+            if (++word == last) {
+                return capacity;
+            }
+            bits = occupancy[word];
+        }
+
+        return word * s_word_bits + static_cast<size_type>(std::countr_zero(bits));
     }
 
     auto check_load() noexcept -> void {
@@ -370,41 +1163,68 @@ private:
     }
 
     auto grow_and_rehash() noexcept -> void {
+        rehash(capacity() * 2);
+    }
+
+    auto rehash(size_type new_capacity) noexcept -> void {
+        // Collect entries starting just after an empty bucket so that no cluster, and therefore no run of equal
+        // keys, is split across the end of the array.
+        auto start = size_type{0};
+        while (is_occupied(m_buckets[start])) {
+            start++;
+        }
+
         std::vector<bucket> buckets;
         buckets.reserve(m_size);
-        for (auto& bucket : m_buckets) {
-            if (bucket.occupied) {
+        for (size_type offset = 1; offset <= capacity(); offset++) {
+            auto& bucket = m_buckets[(start + offset) % capacity()];
+            if (is_occupied(bucket)) {
                 bucket.distance = 0;
                 buckets.emplace_back(std::move(bucket));
             }
         }
 
         std::fill(m_buckets.begin(), m_buckets.end(), bucket{});
-        m_buckets.resize(capacity() * 2);
+        m_buckets.resize(new_capacity);
+        m_occupancy.assign(word_count(new_capacity), word_type{0});
 
         for (auto& bucket : buckets) {
-            auto index = bucket.hash % capacity();
+            auto index = home_index(bucket.hash);
 
-            while (m_buckets[index].occupied) {
+            while (is_occupied(m_buckets[index])) {
                 auto& old = m_buckets[index];
 
                 if (bucket.distance > old.distance) {
+                    if constexpr (Multi) {
+                        break;
+                    }
                     std::swap(bucket, old);
                 }
 
                 bucket.distance++;
-                index = (index + 1) % capacity();
+                index = next_index(index);
             }
 
-            m_buckets[index] = std::move(bucket);
+            if constexpr (Multi) {
+                shift_in(index, std::move(bucket));
+            } else {
+                m_buckets[index] = std::move(bucket);
+                mark_occupied(index);
+            }
         }
     }
 
     static constexpr size_type s_initial_capacity = 8;
     static constexpr float s_grow_factor = 0.75f;
+    static constexpr size_type s_prefetch_distance = 16;
+    static constexpr size_type s_sweep_stride = 0x9e3779b97f4a7c15ull;
+    static constexpr size_type s_word_bits = 64;
 
     size_type m_size;
     std::vector<bucket> m_buckets;
+    // One bit per bucket, set exactly when the bucket is occupied.
+    std::vector<word_type> m_occupancy;
+    std::uint8_t m_generation{1};
 
     hasher m_hasher;
     key_equal m_key_equal;
@@ -0,0 +1,116 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RJH_PAIR_HASH_HPP
+#define RJH_PAIR_HASH_HPP
+
+#include "../concepts.hpp"
+
+#include <cstddef>
+#include <span>
+#include <utility>
+
+namespace rjh::detail {
+// Declares is_avalanching exactly when Hash does, so adaptors keep the tables' trust in the wrapped hasher.
+template<typename Hash>
+struct avalanching_tag {
+
+};
+
+template<concepts::avalanching_hash Hash>
+struct avalanching_tag<Hash> {
+    using is_avalanching = void;
+};
+
+// Hash and equality adaptors that let a hash_table of key/value pairs be probed by the key alone.
+template<typename Key, typename Value, typename Hash>
+struct pair_hash : avalanching_tag<Hash> {
+    using is_transparent = void;
+    using key_type = Key;
+    using const_reference = const std::pair<Key, Value>&;
+    using size_type = std::size_t;
+    using hasher = Hash;
+
+    [[nodiscard]]
+    auto operator()(const_reference pair) const noexcept -> size_type {
+        return hasher{}(pair.first);
+    }
+
+    [[nodiscard]]
+    auto operator()(const key_type& key) const noexcept -> size_type {
+        return hasher{}(key);
+    }
+
+    template<typename K>
+    [[nodiscard]]
+    auto operator()(const K& key) const noexcept -> size_type {
+        return hasher{}(key);
+    }
+
+    auto hash_batch(std::span<const key_type> keys, std::span<size_type> hashes) const noexcept -> void
+        requires concepts::batch_hash_function_object<hasher, key_type> {
+        hasher{}.hash_batch(keys, hashes);
+    }
+};
+
+template<typename Key, typename Value, typename KeyEqual>
+struct pair_key_equal {
+    using is_transparent = void;
+    using key_type = Key;
+    using const_reference = const std::pair<Key, Value>&;
+    using key_equal = KeyEqual;
+
+    [[nodiscard]]
+    auto operator()(const_reference a, const_reference b) const noexcept -> bool {
+        return key_equal{}(a.first, b.first);
+    }
+
+    [[nodiscard]]
+    auto operator()(const_reference a, const key_type& b) const noexcept -> bool {
+        return key_equal{}(a.first, b);
+    }
+
+    [[nodiscard]]
+    auto operator()(const key_type& a, const_reference b) const noexcept -> bool {
+        return key_equal{}(a, b.first);
+    }
+
+    template<typename K>
+    [[nodiscard]]
+    auto operator()(const_reference a, const K& b) const noexcept -> bool {
+        return key_equal{}(a.first, b);
+    }
+
+    template<typename K>
+    [[nodiscard]]
+    auto operator()(const K& a, const_reference b) const noexcept -> bool {
+        return key_equal{}(a, b.first);
+    }
+
+    template<typename K>
+    [[nodiscard]]
+    auto operator()(const key_type& a, const K& b) const noexcept -> bool {
+        return key_equal{}(a, b);
+    }
+
+    template<typename K>
+    [[nodiscard]]
+    auto operator()(const K& a, const key_type& b) const noexcept -> bool {
+        return key_equal{}(a, b);
+    }
+};
+} // namespace rjh::detail
+
+#endif // #ifndef RJH_PAIR_HASH_HPP
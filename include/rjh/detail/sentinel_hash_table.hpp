@@ -0,0 +1,352 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RJH_SENTINEL_HASH_TABLE_HPP
+#define RJH_SENTINEL_HASH_TABLE_HPP
+
+#include "../concepts.hpp"
+#include "../hash.hpp"
+#include "hash_mix.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace rjh::detail {
+template<concepts::sentinel_key Key>
+consteval auto default_sentinel() noexcept -> Key {
+    if constexpr (std::is_pointer_v<Key>) {
+        return nullptr;
+    } else {
+        return std::numeric_limits<Key>::max();
+    }
+}
+
+// A linear probing table whose buckets hold nothing but the element itself. A bucket is empty when its key equals
+// Empty, and lookups and inserts walk from the key's home bucket comparing keys until they reach an empty one, so they
+// load no metadata and hash nothing but the key. Removal shifts later entries of the cluster back into the hole,
+// rehashing only those it passes over, so no tombstone sentinel is needed and none can be reserved. Mapped is void
+// for sets. Empty itself can never be inserted.
+template<
+    concepts::sentinel_key Key,
+    Key Empty,
+    typename Mapped,
+    concepts::hash_function_object<Key> Hash = rjh::hash<Key>,
+    concepts::key_equal_function_object<Key> KeyEqual = std::equal_to<Key>
+>
+class sentinel_hash_table final {
+public:
+    using key_type = Key;
+    using value_type = std::conditional_t<std::is_void_v<Mapped>, key_type, std::pair<key_type, Mapped>>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    template<typename T>
+    class raw_iterator final {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = difference_type;
+        using value_type = T;
+        using pointer = value_type*;
+        using reference = value_type&;
+
+        raw_iterator(pointer ptr, pointer end)
+            : m_pointer{ptr}
+            , m_end{end} {
+
+        }
+
+        auto operator*() const noexcept -> reference {
+            return *m_pointer;
+        }
+
+        auto operator->() const noexcept -> pointer {
+            return m_pointer;
+        }
+
+        auto operator++() noexcept -> raw_iterator& {
+            do {
+                m_pointer++;
+            } while (m_pointer != m_end && key_of(*m_pointer) == Empty);
+            return *this;
+        }
+
+        auto operator++(int) noexcept -> raw_iterator {
+            auto temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        friend auto operator==(const raw_iterator& a, const raw_iterator& b) noexcept -> bool {
+            return a.m_pointer == b.m_pointer;
+        }
+
+        friend auto operator!=(const raw_iterator& a, const raw_iterator& b) noexcept -> bool {
+            return a.m_pointer != b.m_pointer;
+        }
+
+    private:
+        pointer m_pointer, m_end;
+    };
+
+    using iterator = raw_iterator<value_type>;
+    using const_iterator = raw_iterator<const value_type>;
+
+    sentinel_hash_table() : m_size{0}, m_buckets(s_initial_capacity, empty_value()) {
+
+    }
+
+    ~sentinel_hash_table() = default;
+
+    sentinel_hash_table(const sentinel_hash_table&) = default;
+    sentinel_hash_table(sentinel_hash_table&&) = default;
+    sentinel_hash_table& operator=(const sentinel_hash_table&) = default;
+    sentinel_hash_table& operator=(sentinel_hash_table&&) = default;
+
+    // Returns end() and false if the key is the empty sentinel.
+    auto insert(value_type value) noexcept -> std::pair<iterator, bool> {
+        const auto& key = key_of(value);
+        if (key == Empty) {
+            return {end(), false};
+        }
+
+        if (const auto index = find_index(key)) {
+            return {iterator_at(*index), false};
+        }
+
+        check_load();
+        return {iterator_at(place(std::move(value))), true};
+    }
+
+    auto find(const key_type& key) noexcept -> iterator {
+        const auto index = find_index(key);
+        return index ? iterator_at(*index) : end();
+    }
+
+    auto find(const key_type& key) const noexcept -> const_iterator {
+        const auto index = find_index(key);
+        return index ? iterator_at(*index) : end();
+    }
+
+    auto contains(const key_type& key) const noexcept -> bool {
+        return find_index(key).has_value();
+    }
+
+    auto remove(const key_type& key) noexcept -> bool {
+        if (const auto index = find_index(key)) {
+            remove_at(*index);
+            return true;
+        }
+
+        return false;
+    }
+
+    // A removal may shift a later entry back into the current bucket, so the sweep only advances past kept entries.
+    // It starts just after an empty bucket, so no entry is shifted past the sweep or offered twice.
+    template<typename Predicate> requires std::predicate<Predicate&, const_reference>
+    auto erase_if(Predicate predicate) noexcept -> size_type {
+        const auto old_size = m_size;
+        auto start = size_type{0};
+        while (!is_empty(start)) {
+            start++;
+        }
+
+        for (size_type offset = 1; offset < capacity(); ) {
+            const auto index = (start + offset) & (capacity() - 1);
+            if (!is_empty(index) && predicate(std::as_const(m_buckets[index]))) {
+                remove_at(index);
+            } else {
+                offset++;
+            }
+        }
+
+        return old_size - m_size;
+    }
+
+    auto reserve(size_type count) noexcept -> void {
+        auto new_capacity = capacity();
+        while (static_cast<float>(count) / static_cast<float>(new_capacity) >= s_grow_factor) {
+            new_capacity *= 2;
+        }
+
+        if (new_capacity != capacity()) {
+            rehash(new_capacity);
+        }
+    }
+
+    auto clear() noexcept -> void {
+        std::fill(m_buckets.begin(), m_buckets.end(), empty_value());
+        m_size = 0;
+    }
+
+    auto empty() const noexcept -> bool {
+        return size() == 0;
+    }
+
+    auto capacity() const noexcept -> size_type {
+        return m_buckets.size();
+    }
+
+    auto size() const noexcept -> size_type {
+        return m_size;
+    }
+
+    auto begin() noexcept -> iterator {
+        return iterator_at(first_occupied());
+    }
+
+    auto begin() const noexcept -> const_iterator {
+        return iterator_at(first_occupied());
+    }
+
+    auto end() noexcept -> iterator {
+        return iterator_at(capacity());
+    }
+
+    auto end() const noexcept -> const_iterator {
+        return iterator_at(capacity());
+    }
+
+private:
+    static constexpr auto key_of(const value_type& value) noexcept -> const key_type& {
+        if constexpr (std::is_void_v<Mapped>) {
+            return value;
+        } else {
+            return value.first;
+        }
+    }
+
+    static constexpr auto empty_value() noexcept -> value_type {
+        if constexpr (std::is_void_v<Mapped>) {
+            return Empty;
+        } else {
+            return {Empty, Mapped{}};
+        }
+    }
+
+    auto is_empty(size_type index) const noexcept -> bool {
+        return key_of(m_buckets[index]) == Empty;
+    }
+
+    auto iterator_at(size_type index) noexcept -> iterator {
+        return {m_buckets.data() + index, m_buckets.data() + capacity()};
+    }
+
+    auto iterator_at(size_type index) const noexcept -> const_iterator {
+        return {m_buckets.data() + index, m_buckets.data() + capacity()};
+    }
+
+    auto first_occupied() const noexcept -> size_type {
+        auto index = size_type{0};
+        while (index != capacity() && is_empty(index)) {
+            index++;
+        }
+        return index;
+    }
+
+    // Capacity is always a power of two, so reducing a hash or a distance is a mask.
+    auto home_index(const key_type& key) const noexcept -> size_type {
+        if constexpr (concepts::avalanching_hash<hasher>) {
+            return m_hasher(key) & (capacity() - 1);
+        }
+        return mix_hash(m_hasher(key)) & (capacity() - 1);
+    }
+
+    auto next_index(size_type index) const noexcept -> size_type {
+        return (index + 1) & (capacity() - 1);
+    }
+
+    auto find_index(const key_type& key) const noexcept -> std::optional<size_type> {
+        if (key == Empty) {
+            return std::nullopt;
+        }
+
+        for (auto index = home_index(key); !is_empty(index); index = next_index(index)) {
+            if (m_key_equal(key_of(m_buckets[index]), key)) {
+                return index;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    // Inserts value into the first empty bucket from its home and returns that index.
+    auto place(value_type&& value) noexcept -> size_type {
+        auto index = home_index(key_of(value));
+        while (!is_empty(index)) {
+            index = next_index(index);
+        }
+
+        m_buckets[index] = std::move(value);
+        m_size++;
+        return index;
+    }
+
+    // Walks the rest of the cluster and moves back into the hole each entry whose home does not lie between the hole
+    // and the entry, since a lookup for it would otherwise stop at the hole. The hole then moves to where the entry was.
+    auto remove_at(size_type index) noexcept -> void {
+        for (auto next = next_index(index); !is_empty(next); next = next_index(next)) {
+            const auto home = home_index(key_of(m_buckets[next]));
+            if (((next - home) & (capacity() - 1)) >= ((next - index) & (capacity() - 1))) {
+                m_buckets[index] = std::move(m_buckets[next]);
+                index = next;
+            }
+        }
+
+        m_buckets[index] = empty_value();
+        m_size--;
+    }
+
+    auto check_load() noexcept -> void {
+        if (static_cast<float>(size() + 1) / static_cast<float>(capacity()) >= s_grow_factor) {
+            rehash(capacity() * 2);
+        }
+    }
+
+    auto rehash(size_type new_capacity) noexcept -> void {
+        auto buckets = std::move(m_buckets);
+        m_buckets.assign(new_capacity, empty_value());
+        m_size = 0;
+
+        for (auto& value : buckets) {
+            if (key_of(value) != Empty) {
+                place(std::move(value));
+            }
+        }
+    }
+
+    static constexpr size_type s_initial_capacity = 8;
+    static constexpr float s_grow_factor = 0.75f;
+
+    size_type m_size;
+    std::vector<value_type> m_buckets;
+
+    hasher m_hasher;
+    key_equal m_key_equal;
+};
+} // namespace rjh::detail
+
+#endif // #ifndef RJH_SENTINEL_HASH_TABLE_HPP
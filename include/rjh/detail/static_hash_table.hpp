@@ -0,0 +1,342 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RJH_STATIC_HASH_TABLE_HPP
+#define RJH_STATIC_HASH_TABLE_HPP
+
+#include "../concepts.hpp"
+#include "../hash.hpp"
+#include "hash_mix.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace rjh::detail {
+// A Robin Hood table with room for Capacity elements held inline, so it never allocates and never rehashes. The
+// bucket array is sized so that a full table is at most 3/4 loaded. Each bucket's probe distance is kept in a
+// separate byte array, with 0 meaning empty, so probing reads one byte per bucket until a candidate is found.
+//
+// Inserts fail, returning end() and false, when the table is full or when placing the element would push any
+// entry more than probe_limit buckets from its home. Every lookup therefore stops within probe_limit + 1 buckets of
+// its home, whatever the keys. Mapped is void for sets.
+//
+// Every bucket holds a constructed value, and removed entries are reset to a default-constructed one, so keys and
+// mapped values must be default constructible.
+template<
+    std::default_initializable Key,
+    typename Mapped,
+    std::size_t Capacity,
+    concepts::hash_function_object<Key> Hash = rjh::hash<Key>,
+    concepts::key_equal_function_object<Key> KeyEqual = std::equal_to<Key>
+> requires std::is_void_v<Mapped> || std::default_initializable<Mapped>
+class static_hash_table final {
+public:
+    using key_type = Key;
+    using value_type = std::conditional_t<std::is_void_v<Mapped>, key_type, std::pair<key_type, Mapped>>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    static_assert(Capacity > 0, "a static table must have room for at least one element");
+    static_assert(std::is_nothrow_move_constructible_v<value_type> && std::is_nothrow_move_assignable_v<value_type>,
+        "static tables move elements inside noexcept functions");
+
+    static constexpr size_type probe_limit = 32;
+
+    template<typename T>
+    class raw_iterator final {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = difference_type;
+        using value_type = T;
+        using pointer = value_type*;
+        using reference = value_type&;
+
+        raw_iterator(pointer values, const std::uint8_t* distances, size_type index)
+            : m_values{values}
+            , m_distances{distances}
+            , m_index{index} {
+
+        }
+
+        operator raw_iterator<const T>() const noexcept requires (!std::is_const_v<T>) {
+            return {m_values, m_distances, m_index};
+        }
+
+        auto operator*() const noexcept -> reference {
+            return m_values[m_index];
+        }
+
+        auto operator->() const noexcept -> pointer {
+            return m_values + m_index;
+        }
+
+        auto operator++() noexcept -> raw_iterator& {
+            do {
+                m_index++;
+            } while (m_index != s_bucket_count && m_distances[m_index] == 0);
+            return *this;
+        }
+
+        auto operator++(int) noexcept -> raw_iterator {
+            auto temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        friend auto operator==(const raw_iterator& a, const raw_iterator& b) noexcept -> bool {
+            return a.m_values == b.m_values && a.m_index == b.m_index;
+        }
+
+        friend auto operator!=(const raw_iterator& a, const raw_iterator& b) noexcept -> bool {
+            return !(a == b);
+        }
+
+    private:
+        pointer m_values;
+        const std::uint8_t* m_distances;
+        size_type m_index;
+    };
+
+    using iterator = raw_iterator<value_type>;
+    using const_iterator = raw_iterator<const value_type>;
+
+    // Returns end() and false if the table is full or the probe limit would be exceeded.
+    auto insert(value_type&& value) noexcept -> std::pair<iterator, bool> {
+        auto index = home_index(key_of(value));
+        auto distance = size_type{0};
+
+        while (m_distances[index] != 0 && m_distances[index] - 1u >= distance) {
+            if (m_key_equal(key_of(m_values[index]), key_of(value))) {
+                return {iterator_at(index), false};
+            }
+            index = next_index(index);
+            distance++;
+        }
+
+        if (m_size == Capacity || distance > probe_limit) {
+            return {end(), false};
+        }
+
+        // Robin Hood places value at index and shifts the rest of the cluster one bucket along. Checking the
+        // shifted entries first means a refused insert leaves the table untouched.
+        auto last = index;
+        while (m_distances[last] != 0) {
+            if (m_distances[last] > probe_limit) {
+                return {end(), false};
+            }
+            last = next_index(last);
+        }
+
+        while (last != index) {
+            const auto previous = previous_index(last);
+            m_values[last] = std::move(m_values[previous]);
+            m_distances[last] = static_cast<std::uint8_t>(m_distances[previous] + 1);
+            last = previous;
+        }
+
+        m_values[index] = std::move(value);
+        m_distances[index] = static_cast<std::uint8_t>(distance + 1);
+        m_size++;
+        return {iterator_at(index), true};
+    }
+
+    auto find(const key_type& key) noexcept -> iterator {
+        const auto index = find_index(key);
+        return index ? iterator_at(*index) : end();
+    }
+
+    auto find(const key_type& key) const noexcept -> const_iterator {
+        const auto index = find_index(key);
+        return index ? iterator_at(*index) : end();
+    }
+
+    auto contains(const key_type& key) const noexcept -> bool {
+        return find_index(key).has_value();
+    }
+
+    auto remove(const key_type& key) noexcept -> bool {
+        if (const auto index = find_index(key)) {
+            remove_at(*index);
+            return true;
+        }
+
+        return false;
+    }
+
+    // A removal shifts the next entries back into the current bucket, so the sweep only advances past kept entries.
+    // It starts just after an empty bucket, so no entry is shifted past the sweep or offered twice.
+    template<typename Predicate> requires std::predicate<Predicate&, const_reference>
+    auto erase_if(Predicate predicate) noexcept -> size_type {
+        const auto old_size = m_size;
+        auto start = size_type{0};
+        while (m_distances[start] != 0) {
+            start++;
+        }
+
+        for (size_type offset = 1; offset < s_bucket_count; ) {
+            const auto index = (start + offset) & (s_bucket_count - 1);
+            if (m_distances[index] != 0 && predicate(std::as_const(m_values[index]))) {
+                remove_at(index);
+            } else {
+                offset++;
+            }
+        }
+
+        return old_size - m_size;
+    }
+
+    auto clear() noexcept -> void {
+        for (size_type index = 0; index < s_bucket_count; index++) {
+            if (m_distances[index] != 0) {
+                m_values[index] = value_type{};
+                m_distances[index] = 0;
+            }
+        }
+        m_size = 0;
+    }
+
+    // The furthest any current entry sits from its home bucket, which bounds the buckets a successful lookup
+    // visits. Never more than probe_limit.
+    auto longest_probe() const noexcept -> size_type {
+        const auto longest = *std::max_element(m_distances.begin(), m_distances.end());
+        return longest == 0 ? 0 : longest - 1u;
+    }
+
+    auto empty() const noexcept -> bool {
+        return size() == 0;
+    }
+
+    static constexpr auto capacity() noexcept -> size_type {
+        return Capacity;
+    }
+
+    static constexpr auto bucket_count() noexcept -> size_type {
+        return s_bucket_count;
+    }
+
+    auto size() const noexcept -> size_type {
+        return m_size;
+    }
+
+    auto begin() noexcept -> iterator {
+        return iterator_at(first_occupied());
+    }
+
+    auto begin() const noexcept -> const_iterator {
+        return iterator_at(first_occupied());
+    }
+
+    auto end() noexcept -> iterator {
+        return iterator_at(s_bucket_count);
+    }
+
+    auto end() const noexcept -> const_iterator {
+        return iterator_at(s_bucket_count);
+    }
+
+private:
+    static constexpr size_type s_bucket_count = std::bit_ceil(Capacity + Capacity / 3 + 1);
+
+    static constexpr auto key_of(const value_type& value) noexcept -> const key_type& {
+        if constexpr (std::is_void_v<Mapped>) {
+            return value;
+        } else {
+            return value.first;
+        }
+    }
+
+    auto iterator_at(size_type index) noexcept -> iterator {
+        return {m_values.data(), m_distances.data(), index};
+    }
+
+    auto iterator_at(size_type index) const noexcept -> const_iterator {
+        return {m_values.data(), m_distances.data(), index};
+    }
+
+    auto first_occupied() const noexcept -> size_type {
+        auto index = size_type{0};
+        while (index != s_bucket_count && m_distances[index] == 0) {
+            index++;
+        }
+        return index;
+    }
+
+    auto home_index(const key_type& key) const noexcept -> size_type {
+        if constexpr (concepts::avalanching_hash<hasher>) {
+            return m_hasher(key) & (s_bucket_count - 1);
+        }
+        return mix_hash(m_hasher(key)) & (s_bucket_count - 1);
+    }
+
+    static constexpr auto next_index(size_type index) noexcept -> size_type {
+        return (index + 1) & (s_bucket_count - 1);
+    }
+
+    static constexpr auto previous_index(size_type index) noexcept -> size_type {
+        return (index - 1) & (s_bucket_count - 1);
+    }
+
+    auto find_index(const key_type& key) const noexcept -> std::optional<size_type> {
+        auto index = home_index(key);
+        auto distance = size_type{0};
+
+        while (m_distances[index] != 0 && m_distances[index] - 1u >= distance) {
+            if (m_key_equal(key_of(m_values[index]), key)) {
+                return index;
+            }
+            index = next_index(index);
+            distance++;
+        }
+
+        return std::nullopt;
+    }
+
+    auto remove_at(size_type index) noexcept -> void {
+        auto next = next_index(index);
+        while (m_distances[next] > 1) {
+            m_values[index] = std::move(m_values[next]);
+            m_distances[index] = static_cast<std::uint8_t>(m_distances[next] - 1);
+            index = next;
+            next = next_index(next);
+        }
+
+        m_values[index] = value_type{};
+        m_distances[index] = 0;
+        m_size--;
+    }
+
+    size_type m_size{0};
+    std::array<std::uint8_t, s_bucket_count> m_distances{};
+    std::array<value_type, s_bucket_count> m_values{};
+
+    hasher m_hasher;
+    key_equal m_key_equal;
+};
+} // namespace rjh::detail
+
+#endif // #ifndef RJH_STATIC_HASH_TABLE_HPP
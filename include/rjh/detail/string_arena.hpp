@@ -0,0 +1,109 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RJH_STRING_ARENA_HPP
+#define RJH_STRING_ARENA_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace rjh::detail {
+// Append-only storage for string bytes. Memory is handed out from fixed blocks that are never reallocated, so every
+// view returned by store stays valid until the arena is cleared or destroyed, including across moves.
+class string_arena final {
+public:
+    using size_type = std::size_t;
+
+    string_arena() = default;
+    ~string_arena() = default;
+
+    // Copying would leave views pointing into the source arena, so owners must rebuild their views with store.
+    string_arena(const string_arena&) = delete;
+    string_arena& operator=(const string_arena&) = delete;
+
+    string_arena(string_arena&& other) noexcept
+        : m_blocks{std::move(other.m_blocks)}
+        , m_cursor{std::exchange(other.m_cursor, nullptr)}
+        , m_remaining{std::exchange(other.m_remaining, 0)}
+        , m_used{std::exchange(other.m_used, 0)}
+        , m_reserved{std::exchange(other.m_reserved, 0)} {
+        other.m_blocks.clear();
+    }
+
+    string_arena& operator=(string_arena&& other) noexcept {
+        if (this != &other) {
+            m_blocks = std::move(other.m_blocks);
+            m_cursor = std::exchange(other.m_cursor, nullptr);
+            m_remaining = std::exchange(other.m_remaining, 0);
+            m_used = std::exchange(other.m_used, 0);
+            m_reserved = std::exchange(other.m_reserved, 0);
+            other.m_blocks.clear();
+        }
+        return *this;
+    }
+
+    auto store(std::string_view string) noexcept -> std::string_view {
+        if (string.empty()) {
+            return {};
+        }
+
+        if (m_blocks.empty() || m_remaining < string.size()) {
+            const auto block_size = std::max(s_block_size, string.size());
+            m_blocks.push_back(std::make_unique_for_overwrite<char[]>(block_size));
+            m_cursor = m_blocks.back().get();
+            m_remaining = block_size;
+            m_reserved += block_size;
+        }
+
+        const auto data = std::copy(string.begin(), string.end(), m_cursor) - string.size();
+        m_cursor += string.size();
+        m_remaining -= string.size();
+        m_used += string.size();
+        return {data, string.size()};
+    }
+
+    auto clear() noexcept -> void {
+        m_blocks.clear();
+        m_cursor = nullptr;
+        m_remaining = 0;
+        m_used = 0;
+        m_reserved = 0;
+    }
+
+    // Bytes handed out by store, including those of strings the owner no longer references.
+    [[nodiscard]] auto used() const noexcept -> size_type {
+        return m_used;
+    }
+
+    [[nodiscard]] auto reserved() const noexcept -> size_type {
+        return m_reserved;
+    }
+
+private:
+    static constexpr size_type s_block_size = 4096;
+
+    std::vector<std::unique_ptr<char[]>> m_blocks;
+    char* m_cursor{nullptr};
+    size_type m_remaining{0};
+    size_type m_used{0};
+    size_type m_reserved{0};
+}; // class string_arena
+} // namespace rjh::detail
+
+#endif // #ifndef RJH_STRING_ARENA_HPP
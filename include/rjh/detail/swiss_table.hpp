@@ -0,0 +1,926 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RJH_SWISS_TABLE_HPP
+#define RJH_SWISS_TABLE_HPP
+
+#include "../concepts.hpp"
+#include "../hash.hpp"
+#include "hash_mix.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace rjh::detail {
+// One control byte per bucket: the low seven bits of the bucket's mixed hash while it is full, or empty or deleted.
+// Both of those have the top bit set, so full buckets are exactly the non-negative bytes.
+using control_type = std::int8_t;
+
+inline constexpr control_type s_control_empty = -128;
+inline constexpr control_type s_control_deleted = -2;
+
+// Sixteen control bytes matched against a value at once. With SSE2 a match is one compare and a movemask, and anything
+// else compares a byte at a time. Bit i of every mask stands for the i-th byte of the group.
+#if defined(__SSE2__)
+struct control_group {
+    static constexpr std::size_t width = 16;
+
+    __m128i bytes;
+
+    explicit control_group(const control_type* control) noexcept
+        : bytes{_mm_loadu_si128(reinterpret_cast<const __m128i*>(control))} {
+
+    }
+
+    auto match(control_type value) const noexcept -> std::uint32_t {
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(value))));
+    }
+
+    auto match_free() const noexcept -> std::uint32_t {
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(bytes));
+    }
+#else
+struct control_group {
+    static constexpr std::size_t width = 16;
+
+    control_type bytes[width];
+
+    explicit control_group(const control_type* control) noexcept {
+        std::memcpy(bytes, control, width);
+    }
+
+    auto match(control_type value) const noexcept -> std::uint32_t {
+        auto mask = std::uint32_t{0};
+        for (std::size_t i = 0; i < width; i++) {
+            mask |= static_cast<std::uint32_t>(bytes[i] == value) << i;
+        }
+        return mask;
+    }
+
+    auto match_free() const noexcept -> std::uint32_t {
+        auto mask = std::uint32_t{0};
+        for (std::size_t i = 0; i < width; i++) {
+            mask |= static_cast<std::uint32_t>(bytes[i] < 0) << i;
+        }
+        return mask;
+    }
+#endif
+
+    auto match_empty() const noexcept -> std::uint32_t {
+        return match(s_control_empty);
+    }
+
+    auto match_full() const noexcept -> std::uint32_t {
+        return ~match_free() & 0xffffu;
+    }
+}; // struct control_group
+
+// An open-addressing table in the style of Abseil's Swiss tables. A lookup loads sixteen control bytes at a time and
+// only compares keys in buckets whose control byte matches seven bits of the key's hash, probing groups quadratically
+// until a group with an empty byte. Nothing moves once inserted: removal leaves a deleted marker unless the bucket
+// could never have been passed over by a probe, and markers are purged when the table next rehashes. The control array
+// repeats its first group after the last bucket, so a group read never wraps. The interface mirrors hash_table with
+// Multi false. When Generational is true, clear() skips destroying the keys and leaves them to be overwritten when
+// their buckets are reused. It still resets every control byte, so unlike hash_table it stays linear in capacity.
+template<
+    typename Key,
+    concepts::hash_function_object<Key> Hash = rjh::hash<Key>,
+    concepts::key_equal_function_object<Key> KeyEqual = std::equal_to<Key>,
+    bool Generational = false
+>
+class swiss_table final {
+public:
+    using value_type = Key;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using hash_type = std::size_t;
+    using key_equal = KeyEqual;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    struct bucket {
+        value_type key{};
+        hash_type hash{};
+    };
+
+    // Walks full buckets a group of control bytes at a time.
+    template<typename T>
+    class raw_iterator final {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = difference_type;
+        using value_type = T;
+        using pointer = value_type*;
+        using reference = value_type&;
+
+        raw_iterator(pointer buckets, const control_type* control, size_type index, size_type capacity)
+            : m_buckets{buckets}
+            , m_control{control}
+            , m_index{index}
+            , m_capacity{capacity} {
+
+        }
+
+        auto operator*() const noexcept -> reference {
+            return m_buckets[m_index];
+        }
+
+        auto operator->() const noexcept -> pointer {
+            return m_buckets + m_index;
+        }
+
+        auto operator++() noexcept -> raw_iterator& {
+            m_index = next_full(m_control, m_index + 1, m_capacity);
+            return *this;
+        }
+
+        auto operator++(int) noexcept -> raw_iterator {
+            auto temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        friend auto operator==(const raw_iterator& a, const raw_iterator& b) noexcept -> bool {
+            return a.m_buckets == b.m_buckets && a.m_index == b.m_index;
+        }
+
+        friend auto operator!=(const raw_iterator& a, const raw_iterator& b) noexcept -> bool {
+            return !(a == b);
+        }
+
+    private:
+        pointer m_buckets;
+        const control_type* m_control;
+        size_type m_index, m_capacity;
+    };
+
+    using iterator = raw_iterator<bucket>;
+    using const_iterator = raw_iterator<const bucket>;
+
+    // Owns an element removed from a table along with its cached hash, so it can be inserted into another table of
+    // the same type without being rehashed.
+    class node_handle final {
+    public:
+        node_handle() = default;
+
+        [[nodiscard]] auto empty() const noexcept -> bool {
+            return !m_key.has_value();
+        }
+
+        explicit operator bool() const noexcept {
+            return !empty();
+        }
+
+        [[nodiscard]] auto key() noexcept -> reference {
+            return *m_key;
+        }
+
+        [[nodiscard]] auto key() const noexcept -> const_reference {
+            return *m_key;
+        }
+
+        [[nodiscard]] auto hash() const noexcept -> hash_type {
+            return m_hash;
+        }
+
+    private:
+        friend class swiss_table;
+
+        node_handle(value_type&& key, hash_type hash)
+            : m_key{std::move(key)}
+            , m_hash{hash} {
+
+        }
+
+        std::optional<value_type> m_key;
+        hash_type m_hash{};
+    };
+
+    swiss_table()
+        : m_size{0}
+        , m_growth_left{max_load(s_initial_capacity)}
+        , m_buckets(s_initial_capacity)
+        , m_control(s_initial_capacity + s_group_width, s_control_empty) {
+
+    }
+
+    ~swiss_table() = default;
+
+    swiss_table(const swiss_table&) = default;
+    swiss_table(swiss_table&&) = default;
+    swiss_table& operator=(const swiss_table&) = default;
+    swiss_table& operator=(swiss_table&&) = default;
+
+    auto insert(const_reference key) noexcept -> std::pair<iterator, bool> {
+        const auto hash = m_hasher(key);
+        if (find_index(key, hash)) {
+            return {end(), false};
+        }
+
+        return insert_bucket({
+            .key = key,
+            .hash = hash,
+        });
+    }
+
+    auto insert(value_type&& key) noexcept -> std::pair<iterator, bool> {
+        const auto hash = m_hasher(key);
+        if (find_index(key, hash)) {
+            return {end(), false};
+        }
+
+        return insert_bucket({
+            .key = std::move(key),
+            .hash = hash,
+        });
+    }
+
+    template<typename K> requires std::constructible_from<value_type, K&&>
+    auto insert(K&& key) noexcept -> std::pair<iterator, bool> {
+        return insert(value_type(std::forward<K>(key)));
+    }
+
+    // Leaves node untouched if it is empty or its key is already present.
+    auto insert(node_handle&& node) noexcept -> std::pair<iterator, bool> {
+        if (node.empty()) {
+            return {end(), false};
+        }
+
+        if (const auto index = find_index(*node.m_key, node.m_hash)) {
+            return {iterator_at(*index), false};
+        }
+
+        auto result = insert_bucket({
+            .key = std::move(*node.m_key),
+            .hash = node.m_hash,
+        });
+        node.m_key.reset();
+        return result;
+    }
+
+    // Returns the entry equal to key, or inserts the value returned by make under key's hash. make is only called
+    // when key is absent.
+    template<typename K, std::invocable Make> requires std::convertible_to<std::invoke_result_t<Make&>, value_type>
+    auto find_or_insert(const K& key, Make make) noexcept -> std::pair<iterator, bool> {
+        const auto hash = m_hasher(key);
+        if (const auto index = find_index(key, hash)) {
+            return {iterator_at(*index), false};
+        }
+
+        return insert_bucket({
+            .key = make(),
+            .hash = hash,
+        });
+    }
+
+    auto extract(const_reference key) noexcept -> node_handle {
+        const auto index = find_index(key, m_hasher(key));
+        return index ? extract_at(*index) : node_handle{};
+    }
+
+    template<typename K> requires concepts::is_transparent<hasher> && concepts::is_transparent<key_equal>
+    auto extract(const K& key) noexcept -> node_handle {
+        const auto index = find_index(key, m_hasher(key));
+        return index ? extract_at(*index) : node_handle{};
+    }
+
+    auto find(const_reference key) noexcept -> iterator {
+        const auto index = find_index(key, m_hasher(key));
+        return index ? iterator_at(*index) : end();
+    }
+
+    auto find(const_reference key) const noexcept -> const_iterator {
+        const auto index = find_index(key, m_hasher(key));
+        return index ? iterator_at(*index) : end();
+    }
+
+    template<typename K> requires concepts::is_transparent<hasher> && concepts::is_transparent<key_equal>
+    auto find(const K& key) noexcept -> iterator {
+        const auto index = find_index(key, m_hasher(key));
+        return index ? iterator_at(*index) : end();
+    }
+
+    template<typename K> requires concepts::is_transparent<hasher> && concepts::is_transparent<key_equal>
+    auto find(const K& key) const noexcept -> const_iterator {
+        const auto index = find_index(key, m_hasher(key));
+        return index ? iterator_at(*index) : end();
+    }
+
+    auto contains(const_reference key) const noexcept -> bool {
+        return find_index(key, m_hasher(key)).has_value();
+    }
+
+    template<typename K> requires concepts::is_transparent<hasher> && concepts::is_transparent<key_equal>
+    auto contains(const K& key) const noexcept -> bool {
+        return find_index(key, m_hasher(key)).has_value();
+    }
+
+    // Looks key up under a hash the caller already computed with this table's hasher.
+    auto contains(const_reference key, hash_type hash) const noexcept -> bool {
+        return find_index(key, hash).has_value();
+    }
+
+    // Inserts each key in turn and returns how many were inserted. Keys are hashed a batch at a time, through the
+    // hasher's hash_batch when it has one, and the first group of each key in a batch is prefetched before any are
+    // probed.
+    auto insert_bulk(std::span<const value_type> keys) noexcept -> size_type {
+        const auto old_size = m_size;
+        hash_type hashes[s_prefetch_distance];
+
+        for (size_type batch = 0; batch < keys.size(); batch += s_prefetch_distance) {
+            const auto chunk = keys.subspan(batch, std::min(s_prefetch_distance, keys.size() - batch));
+            hash_keys(chunk, hashes);
+
+            for (size_type i = 0; i < chunk.size(); i++) {
+                prefetch(hashes[i]);
+            }
+
+            for (size_type i = 0; i < chunk.size(); i++) {
+                if (!find_index(chunk[i], hashes[i])) {
+                    insert_bucket({
+                        .key = chunk[i],
+                        .hash = hashes[i],
+                    });
+                }
+            }
+        }
+
+        return m_size - old_size;
+    }
+
+    // For each i, passes the entry equal to keys[i] to update(entry, i), or inserts make(i) if there is none. Hashes
+    // and prefetches in batches like insert_bulk.
+    template<typename K, typename Make, typename Update>
+        requires std::convertible_to<std::invoke_result_t<Make&, size_type>, value_type>
+            && std::invocable<Update&, reference, size_type>
+    auto upsert_bulk(std::span<const K> keys, Make make, Update update) noexcept -> void {
+        hash_type hashes[s_prefetch_distance];
+
+        for (size_type batch = 0; batch < keys.size(); batch += s_prefetch_distance) {
+            const auto chunk = keys.subspan(batch, std::min(s_prefetch_distance, keys.size() - batch));
+            hash_keys(chunk, hashes);
+
+            for (size_type i = 0; i < chunk.size(); i++) {
+                prefetch(hashes[i]);
+            }
+
+            for (size_type i = 0; i < chunk.size(); i++) {
+                if (const auto index = find_index(chunk[i], hashes[i])) {
+                    update(m_buckets[*index].key, batch + i);
+                } else {
+                    insert_bucket({
+                        .key = make(batch + i),
+                        .hash = hashes[i],
+                    });
+                }
+            }
+        }
+    }
+
+    // Sets found[i] to whether keys[i] is in the table and returns how many were. found must be at least as long as
+    // keys.
+    auto contains_bulk(std::span<const value_type> keys, std::span<bool> found) const noexcept -> size_type {
+        auto count = size_type{0};
+        hash_type hashes[s_prefetch_distance];
+
+        for (size_type batch = 0; batch < keys.size(); batch += s_prefetch_distance) {
+            const auto chunk = keys.subspan(batch, std::min(s_prefetch_distance, keys.size() - batch));
+            hash_keys(chunk, hashes);
+
+            for (size_type i = 0; i < chunk.size(); i++) {
+                prefetch(hashes[i]);
+            }
+
+            for (size_type i = 0; i < chunk.size(); i++) {
+                found[batch + i] = find_index(chunk[i], hashes[i]).has_value();
+                count += found[batch + i];
+            }
+        }
+
+        return count;
+    }
+
+    auto remove(const_reference key) noexcept -> bool {
+        const auto index = find_index(key, m_hasher(key));
+        if (index) {
+            remove_at(*index);
+        }
+
+        return index.has_value();
+    }
+
+    template<typename K> requires concepts::is_transparent<hasher> && concepts::is_transparent<key_equal>
+    auto remove(K&& key) noexcept -> bool {
+        const auto index = find_index(key, m_hasher(key));
+        if (index) {
+            remove_at(*index);
+        }
+
+        return index.has_value();
+    }
+
+    // Removal never moves other entries, so this is a single pass over the control bytes.
+    template<typename Predicate> requires std::predicate<Predicate&, const_reference>
+    auto erase_if(Predicate predicate, bool shrink = false) noexcept -> size_type {
+        const auto old_size = m_size;
+        for_each_full([this, &predicate](size_type index) {
+            if (predicate(std::as_const(m_buckets[index].key))) {
+                remove_at(index);
+            }
+        });
+
+        if (shrink) {
+            shrink_to_fit();
+        }
+
+        return old_size - m_size;
+    }
+
+    template<typename Predicate> requires std::predicate<Predicate&, const_reference>
+    auto retain(Predicate predicate, bool shrink = false) noexcept -> size_type {
+        return erase_if([&predicate](const_reference key) { return !predicate(key); }, shrink);
+    }
+
+    auto reserve(size_type count) noexcept -> void {
+        auto new_capacity = capacity();
+        while (count > max_load(new_capacity)) {
+            new_capacity *= 2;
+        }
+
+        if (new_capacity != capacity()) {
+            rehash(new_capacity);
+        }
+    }
+
+    // Also purges deleted markers, since it always rebuilds the control bytes when the capacity changes.
+    auto shrink_to_fit() noexcept -> void {
+        auto new_capacity = capacity();
+        while (new_capacity > s_initial_capacity && size() <= max_load(new_capacity / 2)) {
+            new_capacity /= 2;
+        }
+
+        if (new_capacity != capacity()) {
+            rehash(new_capacity);
+            m_buckets.shrink_to_fit();
+            m_control.shrink_to_fit();
+        }
+    }
+
+    auto merge(swiss_table& other) noexcept -> void {
+        if (this == &other || other.empty()) {
+            return;
+        }
+
+        // Nothing to collide with, so adopt the other bucket array wholesale instead of reinserting.
+        if (empty()) {
+            swap_storage(other);
+            return;
+        }
+
+        other.for_each_full([this, &other](size_type index) {
+            auto& entry = other.m_buckets[index];
+            if (!find_index(entry.key, entry.hash)) {
+                insert_bucket(std::move(entry));
+                other.remove_at(index);
+            }
+        });
+    }
+
+    // Moves every entry of other into this table, like merge, except that an entry whose key is already present is
+    // passed to combine(existing, std::move(entry)) instead of being left behind. other is empty afterwards.
+    template<typename Combine> requires std::invocable<Combine&, reference, value_type&&>
+    auto merge_with(swiss_table& other, Combine combine) noexcept -> void {
+        if (this == &other || other.empty()) {
+            return;
+        }
+
+        if (empty()) {
+            swap_storage(other);
+            return;
+        }
+
+        other.for_each_full([this, &other, &combine](size_type index) {
+            auto& entry = other.m_buckets[index];
+            if (const auto existing = find_index(entry.key, entry.hash)) {
+                combine(m_buckets[*existing].key, std::move(entry.key));
+            } else {
+                insert_bucket(std::move(entry));
+            }
+        });
+        other.clear();
+    }
+
+    // The set operations below iterate the smaller table and look its keys up in the larger one in prefetched
+    // batches, so their cost follows the smaller size.
+    auto union_with(const swiss_table& other) noexcept -> void {
+        if (this == &other) {
+            return;
+        }
+
+        if (size() < other.size()) {
+            auto result = other;
+            result.probe_batched(*this, [this, &result](size_type index, std::optional<size_type> found) {
+                if (!found) {
+                    result.insert_bucket(std::move(m_buckets[index]));
+                }
+                return true;
+            });
+            *this = std::move(result);
+            return;
+        }
+
+        probe_batched(other, [this, &other](size_type index, std::optional<size_type> found) {
+            if (!found) {
+                insert_bucket({
+                    .key = other.m_buckets[index].key,
+                    .hash = other.m_buckets[index].hash,
+                });
+            }
+            return true;
+        });
+    }
+
+    auto intersect_with(const swiss_table& other) noexcept -> void {
+        if (this == &other) {
+            return;
+        }
+
+        if (size() <= other.size()) {
+            other.probe_batched(*this, [this](size_type index, std::optional<size_type> found) {
+                if (!found) {
+                    remove_at(index);
+                }
+                return true;
+            });
+            return;
+        }
+
+        swiss_table result;
+        result.reserve(other.size());
+        probe_batched(other, [this, &result](size_type, std::optional<size_type> found) {
+            if (found) {
+                result.insert_bucket({
+                    .key = m_buckets[*found].key,
+                    .hash = m_buckets[*found].hash,
+                });
+            }
+            return true;
+        });
+        *this = std::move(result);
+    }
+
+    auto difference_with(const swiss_table& other) noexcept -> void {
+        if (this == &other) {
+            clear();
+            return;
+        }
+
+        if (size() <= other.size()) {
+            other.probe_batched(*this, [this](size_type index, std::optional<size_type> found) {
+                if (found) {
+                    remove_at(index);
+                }
+                return true;
+            });
+            return;
+        }
+
+        probe_batched(other, [this](size_type, std::optional<size_type> found) {
+            if (found) {
+                remove_at(*found);
+            }
+            return true;
+        });
+    }
+
+    auto is_subset_of(const swiss_table& other) const noexcept -> bool {
+        if (size() > other.size()) {
+            return false;
+        }
+
+        return other.probe_batched(*this, [](size_type, std::optional<size_type> found) {
+            return found.has_value();
+        });
+    }
+
+    // Resets every control byte either way. A generational table only saves destroying the cleared keys.
+    auto clear() noexcept -> void {
+        if constexpr (!Generational) {
+            for_each_full([this](size_type index) {
+                m_buckets[index] = {};
+            });
+        }
+
+        std::fill(m_control.begin(), m_control.end(), s_control_empty);
+        m_size = 0;
+        m_growth_left = max_load(capacity());
+    }
+
+    auto empty() const noexcept -> bool {
+        return size() == 0;
+    }
+
+    auto capacity() const noexcept -> size_type {
+        return m_buckets.size();
+    }
+
+    auto size() const noexcept -> size_type {
+        return m_size;
+    }
+
+    auto begin() noexcept -> iterator {
+        return iterator_at(next_full(m_control.data(), 0, capacity()));
+    }
+
+    auto begin() const noexcept -> const_iterator {
+        return iterator_at(next_full(m_control.data(), 0, capacity()));
+    }
+
+    auto cbegin() const noexcept -> const_iterator {
+        return begin();
+    }
+
+    auto end() noexcept -> iterator {
+        return iterator_at(capacity());
+    }
+
+    auto end() const noexcept -> const_iterator {
+        return iterator_at(capacity());
+    }
+
+    auto cend() const noexcept -> const_iterator {
+        return end();
+    }
+
+private:
+    template<typename K>
+    auto hash_keys(std::span<const K> keys, hash_type* hashes) const noexcept -> void {
+        if constexpr (concepts::batch_hash_function_object<hasher, K>) {
+            m_hasher.hash_batch(keys, std::span{hashes, keys.size()});
+        } else {
+            for (size_type i = 0; i < keys.size(); i++) {
+                hashes[i] = m_hasher(keys[i]);
+            }
+        }
+    }
+
+    // The top bits of the mixed hash choose the first group and the low seven become the control byte.
+    static auto mixed(hash_type hash) noexcept -> hash_type {
+        if constexpr (concepts::avalanching_hash<hasher>) {
+            return hash;
+        }
+        return mix_hash(hash);
+    }
+
+    static auto control_of(hash_type mixed_hash) noexcept -> control_type {
+        return static_cast<control_type>(mixed_hash & 0x7f);
+    }
+
+    auto home_index(hash_type mixed_hash) const noexcept -> size_type {
+        return (mixed_hash >> 7) & (capacity() - 1);
+    }
+
+    template<typename K>
+    auto find_index(const K& key, hash_type hash) const noexcept -> std::optional<size_type> {
+        const auto mixed_hash = mixed(hash);
+        const auto control = control_of(mixed_hash);
+        const auto mask = capacity() - 1;
+        auto index = home_index(mixed_hash);
+
+        for (auto step = s_group_width; ; step += s_group_width) {
+            const control_group group{m_control.data() + index};
+            for (auto matches = group.match(control); matches != 0; matches &= matches - 1) {
+                const auto candidate = (index + static_cast<size_type>(std::countr_zero(matches))) & mask;
+                const auto& entry = m_buckets[candidate];
+                if (entry.hash == hash && m_key_equal(entry.key, key)) {
+                    return candidate;
+                }
+            }
+
+            if (group.match_empty() != 0) {
+                return std::nullopt;
+            }
+            index = (index + step) & mask;
+        }
+    }
+
+    // Returns the first empty or deleted bucket on hash's probe sequence. There always is one, since the table
+    // grows before its last empty bucket is used.
+    auto find_free(hash_type mixed_hash) const noexcept -> size_type {
+        const auto mask = capacity() - 1;
+        auto index = home_index(mixed_hash);
+
+        for (auto step = s_group_width; ; step += s_group_width) {
+            if (const auto free = control_group{m_control.data() + index}.match_free(); free != 0) {
+                return (index + static_cast<size_type>(std::countr_zero(free))) & mask;
+            }
+            index = (index + step) & mask;
+        }
+    }
+
+    auto prefetch(hash_type hash) const noexcept -> void {
+#if defined(__GNUC__) || defined(__clang__)
+        const auto index = home_index(mixed(hash));
+        __builtin_prefetch(m_control.data() + index);
+        __builtin_prefetch(m_buckets.data() + index);
+#else
+        static_cast<void>(hash);
+#endif
+    }
+
+    auto insert_bucket(bucket&& entry) noexcept -> std::pair<iterator, bool> {
+        if (m_growth_left == 0) {
+            make_room();
+        }
+
+        const auto mixed_hash = mixed(entry.hash);
+        const auto index = find_free(mixed_hash);
+        m_growth_left -= m_control[index] == s_control_empty;
+        set_control(index, control_of(mixed_hash));
+        m_buckets[index] = std::move(entry);
+        m_size++;
+        return {iterator_at(index), true};
+    }
+
+    // Out of empty buckets. If deleted markers account for much of the load, rebuilding at the same capacity frees
+    // them; otherwise the table doubles.
+    auto make_room() noexcept -> void {
+        if (m_size < max_load(capacity()) / 2) {
+            rehash(capacity());
+        } else {
+            rehash(capacity() * 2);
+        }
+    }
+
+    auto extract_at(size_type index) noexcept -> node_handle {
+        auto& entry = m_buckets[index];
+        node_handle node{std::move(entry.key), entry.hash};
+        remove_at(index);
+        return node;
+    }
+
+    // A probe only passes over a bucket when every group it loads around it is free of empty bytes. If the empty
+    // bytes on either side of index are less than a group apart, no such group exists and the bucket can go back to
+    // empty; otherwise it must become a deleted marker so those probes keep going.
+    auto remove_at(size_type index) noexcept -> void {
+        const auto mask = capacity() - 1;
+        const auto after = control_group{m_control.data() + index}.match_empty();
+        const auto before = control_group{m_control.data() + ((index - s_group_width) & mask)}.match_empty();
+        const auto reusable = after != 0 && before != 0
+            && static_cast<size_type>(std::countr_zero(after) + std::countl_zero(static_cast<std::uint16_t>(before)))
+                < s_group_width;
+
+        m_buckets[index] = {};
+        set_control(index, reusable ? s_control_empty : s_control_deleted);
+        m_growth_left += reusable;
+        m_size--;
+    }
+
+    auto set_control(size_type index, control_type control) noexcept -> void {
+        m_control[index] = control;
+        if (index < s_group_width) {
+            m_control[capacity() + index] = control;
+        }
+    }
+
+    // Looks up every full bucket of source in this table, prefetching the home buckets of a whole batch before
+    // probing any of them, and calls fn(source index, index found here). Removal moves nothing, so fn may remove the
+    // bucket at either index. Stops early if fn returns false.
+    template<typename Fn>
+    auto probe_batched(const swiss_table& source, Fn fn) const noexcept -> bool {
+        size_type batch[s_prefetch_distance];
+        const auto* control = source.m_control.data();
+        auto index = next_full(control, 0, source.capacity());
+
+        while (index != source.capacity()) {
+            auto count = size_type{0};
+            for (; count < s_prefetch_distance && index != source.capacity(); count++) {
+                batch[count] = index;
+                prefetch(source.m_buckets[index].hash);
+                index = next_full(control, index + 1, source.capacity());
+            }
+
+            for (size_type i = 0; i < count; i++) {
+                const auto& entry = source.m_buckets[batch[i]];
+                if (!fn(batch[i], find_index(entry.key, entry.hash))) {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    // Calls fn(index) for every full bucket. fn may remove the bucket at index, since removal moves nothing.
+    template<typename Fn>
+    auto for_each_full(Fn fn) noexcept -> void {
+        for (auto index = next_full(m_control.data(), 0, capacity());
+            index != capacity();
+            index = next_full(m_control.data(), index + 1, capacity())) {
+            fn(index);
+        }
+    }
+
+    template<typename Fn>
+    auto for_each_full(Fn fn) const noexcept -> void {
+        for (auto index = next_full(m_control.data(), 0, capacity());
+            index != capacity();
+            index = next_full(m_control.data(), index + 1, capacity())) {
+            fn(index);
+        }
+    }
+
+    auto iterator_at(size_type index) noexcept -> iterator {
+        return iterator{m_buckets.data(), m_control.data(), index, capacity()};
+    }
+
+    auto iterator_at(size_type index) const noexcept -> const_iterator {
+        return const_iterator{m_buckets.data(), m_control.data(), index, capacity()};
+    }
+
+    auto swap_storage(swiss_table& other) noexcept -> void {
+        std::swap(m_buckets, other.m_buckets);
+        std::swap(m_control, other.m_control);
+        std::swap(m_size, other.m_size);
+        std::swap(m_growth_left, other.m_growth_left);
+    }
+
+    // Returns the first full index at or after index, or capacity if there is none. A group read near the end runs
+    // into the mirrored bytes, whose matches stand for buckets already passed, so they count as none.
+    static auto next_full(const control_type* control, size_type index, size_type capacity) noexcept -> size_type {
+        for (; index < capacity; index += s_group_width) {
+            if (const auto full = control_group{control + index}.match_full(); full != 0) {
+                return std::min(index + static_cast<size_type>(std::countr_zero(full)), capacity);
+            }
+        }
+
+        return capacity;
+    }
+
+    // Keeps at least one bucket in eight empty, so every probe sequence ends.
+    static constexpr auto max_load(size_type capacity) noexcept -> size_type {
+        return capacity - capacity / 8;
+    }
+
+    auto rehash(size_type new_capacity) noexcept -> void {
+        auto buckets = std::move(m_buckets);
+        auto control = std::move(m_control);
+        const auto old_capacity = buckets.size();
+
+        m_buckets = std::vector<bucket>(new_capacity);
+        m_control.assign(new_capacity + s_group_width, s_control_empty);
+        m_growth_left = max_load(new_capacity) - m_size;
+
+        for (auto index = next_full(control.data(), 0, old_capacity);
+            index != old_capacity;
+            index = next_full(control.data(), index + 1, old_capacity)) {
+            const auto mixed_hash = mixed(buckets[index].hash);
+            const auto target = find_free(mixed_hash);
+            set_control(target, control_of(mixed_hash));
+            m_buckets[target] = std::move(buckets[index]);
+        }
+    }
+
+    static constexpr size_type s_group_width = control_group::width;
+    static constexpr size_type s_initial_capacity = s_group_width;
+    static constexpr size_type s_prefetch_distance = 16;
+
+    size_type m_size;
+    // Buckets that can still become full before the table must grow. Deleted markers count against it until a rehash.
+    size_type m_growth_left;
+    std::vector<bucket> m_buckets;
+    std::vector<control_type> m_control;
+
+    hasher m_hasher;
+    key_equal m_key_equal;
+};
+} // namespace rjh::detail
+
+#endif // #ifndef RJH_SWISS_TABLE_HPP
@@ -0,0 +1,205 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RJH_FILTERED_UNORDERED_SET_HPP
+#define RJH_FILTERED_UNORDERED_SET_HPP
+
+#include "detail/bloom_filter.hpp"
+#include "detail/hash_table.hpp"
+#include "hash.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+namespace rjh {
+// An unordered_set with a blocked Bloom filter in front of its bucket array, for workloads where most lookups miss.
+// The filter is built from the hashes the table already caches and holds 16 bits per bucket, so contains() rejects
+// most absent keys with one access to a structure 1/16 the size of the buckets. Erased keys stay in the filter until
+// it is rebuilt, which happens on growth, on clear, and once erased keys outnumber live ones.
+template<typename Key, typename Hash = rjh::hash<Key>>
+class filtered_unordered_set {
+public:
+    using value_type = Key;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+private:
+    using hash_table = detail::hash_table<value_type, hasher>;
+
+public:
+    template<typename It>
+    class raw_iterator final {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type  = difference_type;
+        using value_type = Key;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+        using table_iterator = It;
+
+        raw_iterator(table_iterator it) : m_iterator{it} {
+
+        }
+
+        auto operator*() const noexcept -> reference {
+            return m_iterator->key;
+        }
+
+        auto operator->() const noexcept -> pointer {
+            return &m_iterator->key;
+        }
+
+        auto operator++() noexcept -> raw_iterator& {
+            m_iterator++;
+            return *this;
+        }
+
+        auto operator++(int) noexcept -> raw_iterator {
+            auto temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        friend auto operator==(const raw_iterator& a, const raw_iterator& b) noexcept -> bool {
+            return a.m_iterator == b.m_iterator;
+        }
+
+        friend auto operator!=(const raw_iterator& a, const raw_iterator& b) noexcept -> bool {
+            return a.m_iterator != b.m_iterator;
+        }
+
+    private:
+        table_iterator m_iterator;
+    };
+
+    using iterator = raw_iterator<typename hash_table::iterator>;
+    using const_iterator = raw_iterator<typename hash_table::const_iterator>;
+
+    filtered_unordered_set() {
+        rebuild_filter();
+    }
+
+    auto insert(const_reference key) noexcept -> std::pair<iterator, bool> {
+        return track(m_hash_table.insert(key));
+    }
+
+    auto insert(value_type&& key) noexcept -> std::pair<iterator, bool> {
+        return track(m_hash_table.insert(std::move(key)));
+    }
+
+    auto contains(const_reference key) const noexcept -> bool {
+        const auto hash = m_hasher(key);
+        return m_filter.may_contain(hash) && m_hash_table.contains(key, hash);
+    }
+
+    // Returns false only if key is certainly absent, without touching the bucket array.
+    auto may_contain(const_reference key) const noexcept -> bool {
+        return m_filter.may_contain(m_hasher(key));
+    }
+
+    auto find(const_reference key) const noexcept -> const_iterator {
+        return m_filter.may_contain(m_hasher(key)) ? m_hash_table.find(key) : m_hash_table.end();
+    }
+
+    auto erase(const_reference key) noexcept -> bool {
+        if (!m_hash_table.remove(key)) {
+            return false;
+        }
+
+        if (++m_erased > size()) {
+            rebuild_filter();
+        }
+        return true;
+    }
+
+    auto reserve(size_type count) noexcept -> void {
+        m_hash_table.reserve(count);
+        rebuild_filter();
+    }
+
+    auto clear() noexcept -> void {
+        m_hash_table.clear();
+        rebuild_filter();
+    }
+
+    [[nodiscard]] auto empty() const noexcept -> bool {
+        return m_hash_table.empty();
+    }
+
+    [[nodiscard]] auto capacity() const noexcept -> size_type {
+        return m_hash_table.capacity();
+    }
+
+    [[nodiscard]] auto size() const noexcept -> size_type {
+        return m_hash_table.size();
+    }
+
+    [[nodiscard]] auto begin() const noexcept -> const_iterator {
+        return m_hash_table.begin();
+    }
+
+    [[nodiscard]] auto cbegin() const noexcept -> const_iterator {
+        return m_hash_table.cbegin();
+    }
+
+    [[nodiscard]] auto end() const noexcept -> const_iterator {
+        return m_hash_table.end();
+    }
+
+    [[nodiscard]] auto cend() const noexcept -> const_iterator {
+        return m_hash_table.cend();
+    }
+
+private:
+    // Adds a newly inserted key's cached hash to the filter, rebuilding it instead if the insert grew the table.
+    auto track(std::pair<typename hash_table::iterator, bool> result) noexcept -> std::pair<iterator, bool> {
+        if (result.second) {
+            if (filter_words() != m_filter.word_count()) {
+                rebuild_filter();
+            } else {
+                m_filter.add(result.first->hash);
+            }
+        }
+        return result;
+    }
+
+    auto filter_words() const noexcept -> size_type {
+        return std::max<size_type>(capacity() * s_filter_bits_per_bucket / 64, 1);
+    }
+
+    auto rebuild_filter() noexcept -> void {
+        m_filter.reset(filter_words());
+        for (const auto& entry : m_hash_table) {
+            m_filter.add(entry.hash);
+        }
+        m_erased = 0;
+    }
+
+    static constexpr size_type s_filter_bits_per_bucket = 16;
+
+    hash_table m_hash_table;
+    detail::bloom_filter m_filter;
+    size_type m_erased{0};
+    hasher m_hasher;
+}; // class filtered_unordered_set
+} // namespace rjh
+
+#endif // #ifndef RJH_FILTERED_UNORDERED_SET_HPP
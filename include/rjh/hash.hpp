@@ -0,0 +1,95 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RJH_HASH_HPP
+#define RJH_HASH_HPP
+
+#include "detail/hash_kernels.hpp"
+#include "detail/hash_mix.hpp"
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <type_traits>
+
+namespace rjh {
+// Default hasher for every rjh container. Integers and pointers are mixed so that every bit of the key affects every
+// bit of the hash, where std::hash is usually the identity. Other types fall back to std::hash.
+//
+// Hashers that declare is_avalanching are trusted to produce well-distributed hashes, and tables reduce them to a
+// bucket index without mixing them again. Hashers with a hash_batch member can hash a whole span of keys at once;
+// the integer and byte array specialisations use SIMD kernels for this when built with AVX2 enabled.
+template<typename Key>
+struct hash : std::hash<Key> {
+
+};
+
+template<std::integral Key> requires (!std::same_as<Key, bool>)
+struct hash<Key> {
+    using is_avalanching = void;
+
+    [[nodiscard]]
+    auto operator()(Key key) const noexcept -> std::size_t {
+        return detail::mix_hash(static_cast<word_type>(key));
+    }
+
+    // Writes the hash of keys[i] to hashes[i]. hashes must be at least as long as keys.
+    auto hash_batch(std::span<const Key> keys, std::span<std::size_t> hashes) const noexcept -> void {
+        if constexpr (sizeof(Key) == 4 || sizeof(Key) == 8) {
+            detail::mix_words(reinterpret_cast<const word_type*>(keys.data()), hashes.data(), keys.size());
+        } else {
+            for (std::size_t i = 0; i < keys.size(); i++) {
+                hashes[i] = (*this)(keys[i]);
+            }
+        }
+    }
+
+private:
+    using word_type = std::make_unsigned_t<Key>;
+};
+
+template<typename T>
+struct hash<T*> {
+    using is_avalanching = void;
+
+    [[nodiscard]]
+    auto operator()(T* key) const noexcept -> std::size_t {
+        return detail::mix_hash(reinterpret_cast<std::uintptr_t>(key));
+    }
+};
+
+// Fixed-width byte keys, such as digests or packed identifiers.
+template<typename Byte, std::size_t Size>
+    requires std::same_as<Byte, std::byte> || std::same_as<Byte, char> || std::same_as<Byte, unsigned char>
+struct hash<std::array<Byte, Size>> {
+    using is_avalanching = void;
+    using key_type = std::array<Byte, Size>;
+
+    [[nodiscard]]
+    auto operator()(const key_type& key) const noexcept -> std::size_t {
+        return detail::hash_bytes<Size>(reinterpret_cast<const std::byte*>(key.data()));
+    }
+
+    // Writes the hash of keys[i] to hashes[i]. hashes must be at least as long as keys.
+    auto hash_batch(std::span<const key_type> keys, std::span<std::size_t> hashes) const noexcept -> void {
+        detail::hash_bytes_batch<Size>(reinterpret_cast<const std::byte*>(keys.data()), hashes.data(), keys.size());
+    }
+};
+} // namespace rjh
+
+#endif // #ifndef RJH_HASH_HPP
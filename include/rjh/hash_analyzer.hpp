@@ -0,0 +1,434 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RJH_HASH_ANALYZER_HPP
+#define RJH_HASH_ANALYZER_HPP
+
+#include "concepts.hpp"
+#include "detail/hash_mix.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace rjh {
+// Offline checks of a hasher against a sample of real keys, for vetting a custom Hash before it goes into a table.
+// analyze_hash runs all of them. The sample should hold distinct keys; a hasher that maps distinct keys to equal hashes
+// shows up as distinct_hashes falling short of keys.
+
+// How a table turns a hash into a bucket index.
+enum class index_reduction {
+    // hash & (buckets - 1). What rjh tables do with hashers that declare is_avalanching.
+    mask,
+    // mix_hash(hash) & (buckets - 1). What rjh tables do with every other hasher.
+    mix_then_mask,
+    // The top bits of hash * 2^64 / phi.
+    fibonacci,
+    // The high word of hash * buckets, which keeps the top bits of the hash.
+    fastrange,
+    // hash % buckets with a prime bucket count, like libstdc++'s std::unordered_map.
+    modulo_prime,
+};
+
+inline constexpr std::array<index_reduction, 5> all_index_reductions{
+    index_reduction::mask,
+    index_reduction::mix_then_mask,
+    index_reduction::fibonacci,
+    index_reduction::fastrange,
+    index_reduction::modulo_prime,
+};
+
+constexpr auto to_string(index_reduction reduction) noexcept -> std::string_view {
+    switch (reduction) {
+        case index_reduction::mask:
+            return "mask";
+        case index_reduction::mix_then_mask:
+            return "mix_then_mask";
+        case index_reduction::fibonacci:
+            return "fibonacci";
+        case index_reduction::fastrange:
+            return "fastrange";
+        case index_reduction::modulo_prime:
+            return "modulo_prime";
+    }
+    return "unknown";
+}
+
+// How flipping one bit of a key changes its hash, measured over every bit of the first keys of the sample. An ideal
+// hash flips each output bit with probability 1/2, whichever input bit changed.
+struct avalanche_report {
+    std::size_t keys{0};
+    // Bits per key that were flipped. For strings, bits of the first 64 characters.
+    std::size_t input_bits{0};
+    // Output bits that change per single-bit flip, out of 64. 32 is ideal.
+    double mean_flipped_bits{0};
+    // |P(output bit flips) - 1/2| averaged over every input and output bit pair. 0 is ideal, although sampling noise
+    // alone gives about 0.4 / sqrt(keys).
+    double mean_bias{0};
+    // The largest bias of any pair. 1/2 means some output bit always or never follows some input bit.
+    double worst_bias{0};
+    // Input bits that never changed the hash, such as struct padding or fields the hasher ignores.
+    std::size_t dead_input_bits{0};
+};
+
+// How the sample's hashes spread over a table with at least one bucket per key.
+struct bucket_report {
+    index_reduction reduction{};
+    std::size_t buckets{0};
+    double empty_fraction{0};
+    // What a uniformly random hash would leave empty.
+    double expected_empty_fraction{0};
+    std::size_t largest_bucket{0};
+    // The sum of squared bucket sizes over what a uniformly random hash would give. Near 1 is ideal; 2 means a
+    // lookup meets about twice as many colliding keys.
+    double collision_ratio{0};
+};
+
+// Probe distances after inserting the sample's hashes into a simulated Robin Hood table at a given load factor.
+struct probe_report {
+    index_reduction reduction{};
+    double load_factor{0};
+    std::size_t buckets{0};
+    std::size_t keys{0};
+    double mean_distance{0};
+    std::size_t p99_distance{0};
+    std::size_t max_distance{0};
+    // The same table filled from uniformly random hashes, as a reference.
+    double ideal_mean_distance{0};
+    std::size_t ideal_max_distance{0};
+    // distance_counts[d] is the number of entries d buckets from their home.
+    std::vector<std::size_t> distance_counts{};
+};
+
+struct hash_report {
+    std::size_t keys{0};
+    std::size_t distinct_hashes{0};
+    // Only for keys whose bits can be flipped: trivially copyable types other than bool, and std::string.
+    std::optional<avalanche_report> avalanche{};
+    std::vector<bucket_report> buckets{};
+    std::vector<probe_report> probes{};
+};
+
+struct hash_analysis_options {
+    // How many keys from the front of the sample have every bit flipped.
+    std::size_t avalanche_keys{1000};
+    std::vector<double> load_factors{0.5, 0.75, 0.9};
+    std::vector<index_reduction> reductions{all_index_reductions.begin(), all_index_reductions.end()};
+};
+
+namespace detail {
+template<typename Key>
+concept bit_flippable = (std::is_trivially_copyable_v<Key> && !std::same_as<Key, bool>) || std::same_as<Key, std::string>;
+
+inline constexpr std::size_t s_max_string_flip_bytes = 64;
+
+template<bit_flippable Key>
+auto flippable_bytes(const Key& key) noexcept -> std::size_t {
+    if constexpr (std::same_as<Key, std::string>) {
+        return std::min(key.size(), s_max_string_flip_bytes);
+    } else {
+        return sizeof(Key);
+    }
+}
+
+template<bit_flippable Key>
+auto flip_bit(Key& key, std::size_t bit) noexcept -> void {
+    unsigned char* bytes;
+    if constexpr (std::same_as<Key, std::string>) {
+        bytes = reinterpret_cast<unsigned char*>(key.data());
+    } else {
+        bytes = reinterpret_cast<unsigned char*>(std::addressof(key));
+    }
+    bytes[bit / 8] ^= static_cast<unsigned char>(1u << (bit % 8));
+}
+
+constexpr auto is_prime(std::size_t value) noexcept -> bool {
+    if (value < 2) {
+        return false;
+    }
+    for (std::size_t divisor = 2; divisor * divisor <= value; divisor++) {
+        if (value % divisor == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+constexpr auto next_prime(std::size_t value) noexcept -> std::size_t {
+    while (!is_prime(value)) {
+        value++;
+    }
+    return value;
+}
+
+// A power of two at least count, or the next prime after it for modulo_prime.
+constexpr auto bucket_count_for(std::size_t count, index_reduction reduction) noexcept -> std::size_t {
+    const auto power = std::bit_ceil(std::max<std::size_t>(count, 2));
+    return reduction == index_reduction::modulo_prime ? next_prime(power) : power;
+}
+
+// The high 64 bits of the 128-bit product a * b.
+constexpr auto multiply_high(std::uint64_t a, std::uint64_t b) noexcept -> std::uint64_t {
+    const auto low_low = (a & 0xffffffffull) * (b & 0xffffffffull);
+    const auto low_high = (a & 0xffffffffull) * (b >> 32);
+    const auto high_low = (a >> 32) * (b & 0xffffffffull);
+    const auto high_high = (a >> 32) * (b >> 32);
+    const auto cross = (low_low >> 32) + (low_high & 0xffffffffull) + high_low;
+    return high_high + (low_high >> 32) + (cross >> 32);
+}
+
+constexpr auto reduce(std::size_t hash, std::size_t buckets, index_reduction reduction) noexcept -> std::size_t {
+    switch (reduction) {
+        case index_reduction::mask:
+            return hash & (buckets - 1);
+        case index_reduction::mix_then_mask:
+            return mix_hash(hash) & (buckets - 1);
+        case index_reduction::fibonacci:
+            return (hash * 0x9e3779b97f4a7c15ull) >> (64 - std::countr_zero(buckets));
+        case index_reduction::fastrange:
+            return multiply_high(hash, buckets);
+        case index_reduction::modulo_prime:
+            return hash % buckets;
+    }
+    return 0;
+}
+
+// Returns how many entries end up at each probe distance once every home is inserted into a Robin Hood table with
+// the given number of buckets. Robin Hood keeps each cluster sorted by home bucket, so the distances follow from the
+// count of entries per home without replaying the inserts: the entries homed at bucket i queue behind the carry of
+// entries that overflowed from the buckets before it and take distances carry, carry + 1 and so on. The carry into
+// bucket 0 is whatever overflows off the end, found with one lap from a zero carry, which meets the true carry at
+// the first bucket left empty. homes must number fewer than buckets.
+inline auto robin_hood_distances(std::span<const std::size_t> homes, std::size_t buckets) noexcept
+    -> std::vector<std::size_t> {
+    std::vector<std::size_t> per_home(buckets);
+    for (const auto home : homes) {
+        per_home[home]++;
+    }
+
+    const auto next_carry = [](std::size_t carry, std::size_t arriving) {
+        return carry + arriving == 0 ? 0 : carry + arriving - 1;
+    };
+
+    auto carry = std::size_t{0};
+    for (const auto arriving : per_home) {
+        carry = next_carry(carry, arriving);
+    }
+
+    std::vector<std::size_t> counts;
+    for (const auto arriving : per_home) {
+        if (arriving != 0) {
+            counts.resize(std::max(counts.size(), carry + arriving));
+            for (auto distance = carry; distance < carry + arriving; distance++) {
+                counts[distance]++;
+            }
+        }
+        carry = next_carry(carry, arriving);
+    }
+    return counts;
+}
+} // namespace detail
+
+template<typename Key, concepts::hash_function_object<Key> Hash> requires detail::bit_flippable<Key>
+auto analyze_avalanche(std::span<const Key> keys, const Hash& hasher, std::size_t key_count) noexcept
+    -> avalanche_report {
+    static_assert(sizeof(std::size_t) == 8, "avalanche statistics assume 64-bit hashes");
+    static constexpr std::size_t output_bits = 64;
+
+    keys = keys.first(std::min(keys.size(), key_count));
+    auto input_bits = std::size_t{0};
+    for (const auto& key : keys) {
+        input_bits = std::max(input_bits, detail::flippable_bytes(key) * 8);
+    }
+
+    // flips[input * 64 + output] counts the flips of input that changed output.
+    std::vector<std::size_t> flips(input_bits * output_bits);
+    std::vector<std::size_t> trials(input_bits);
+    auto flipped_bits = std::size_t{0};
+
+    for (const auto& key : keys) {
+        const auto hash = hasher(key);
+        auto copy = key;
+        for (std::size_t input = 0; input < detail::flippable_bytes(key) * 8; input++) {
+            detail::flip_bit(copy, input);
+            const auto changed = hasher(std::as_const(copy)) ^ hash;
+            detail::flip_bit(copy, input);
+
+            trials[input]++;
+            flipped_bits += static_cast<std::size_t>(std::popcount(changed));
+            for (auto bits = changed; bits != 0; bits &= bits - 1) {
+                flips[input * output_bits + static_cast<std::size_t>(std::countr_zero(bits))]++;
+            }
+        }
+    }
+
+    avalanche_report report{
+        .keys = keys.size(),
+        .input_bits = input_bits,
+    };
+
+    auto total_trials = std::size_t{0};
+    auto pairs = std::size_t{0};
+    auto total_bias = 0.0;
+    for (std::size_t input = 0; input < input_bits; input++) {
+        if (trials[input] == 0) {
+            continue;
+        }
+
+        auto any = false;
+        for (std::size_t output = 0; output < output_bits; output++) {
+            const auto count = flips[input * output_bits + output];
+            const auto bias = std::abs(static_cast<double>(count) / static_cast<double>(trials[input]) - 0.5);
+            any = any || count != 0;
+            total_bias += bias;
+            report.worst_bias = std::max(report.worst_bias, bias);
+            pairs++;
+        }
+        report.dead_input_bits += !any;
+        total_trials += trials[input];
+    }
+
+    if (total_trials != 0) {
+        report.mean_flipped_bits = static_cast<double>(flipped_bits) / static_cast<double>(total_trials);
+        report.mean_bias = total_bias / static_cast<double>(pairs);
+    }
+    return report;
+}
+
+inline auto analyze_buckets(std::span<const std::size_t> hashes, index_reduction reduction) noexcept -> bucket_report {
+    const auto buckets = detail::bucket_count_for(hashes.size(), reduction);
+    std::vector<std::size_t> sizes(buckets);
+    for (const auto hash : hashes) {
+        sizes[detail::reduce(hash, buckets, reduction)]++;
+    }
+
+    const auto n = static_cast<double>(hashes.size());
+    const auto m = static_cast<double>(buckets);
+    auto squares = 0.0;
+    for (const auto size : sizes) {
+        squares += static_cast<double>(size) * static_cast<double>(size);
+    }
+
+    const auto expected_squares = n + n * (n - 1) / m;
+    return {
+        .reduction = reduction,
+        .buckets = buckets,
+        .empty_fraction = static_cast<double>(std::count(sizes.begin(), sizes.end(), 0)) / m,
+        .expected_empty_fraction = std::pow(1 - 1 / m, n),
+        .largest_bucket = *std::max_element(sizes.begin(), sizes.end()),
+        .collision_ratio = expected_squares == 0 ? 1 : squares / expected_squares,
+    };
+}
+
+// Uses the largest power-of-two table, or the prime just above it, that the sample fills to load_factor. At least one
+// bucket is left empty whatever the load factor.
+inline auto simulate_probes(std::span<const std::size_t> hashes, double load_factor, index_reduction reduction) noexcept
+    -> probe_report {
+    const auto power = std::bit_floor(std::max<std::size_t>(
+        static_cast<std::size_t>(static_cast<double>(hashes.size()) / load_factor), 2));
+    const auto buckets = reduction == index_reduction::modulo_prime ? detail::next_prime(power) : power;
+    const auto keys = std::min({
+        hashes.size(),
+        static_cast<std::size_t>(load_factor * static_cast<double>(buckets)),
+        buckets - 1,
+    });
+
+    std::vector<std::size_t> homes(keys);
+    for (std::size_t i = 0; i < keys; i++) {
+        homes[i] = detail::reduce(hashes[i], buckets, reduction);
+    }
+    auto counts = detail::robin_hood_distances(homes, buckets);
+
+    // The reference table is fed mixed counters, which behave like uniformly random hashes.
+    for (std::size_t i = 0; i < keys; i++) {
+        homes[i] = detail::reduce(detail::mix_hash(i + 0x9e3779b97f4a7c15ull), buckets, index_reduction::fastrange);
+    }
+    const auto ideal = detail::robin_hood_distances(homes, buckets);
+
+    const auto mean = [keys](const std::vector<std::size_t>& histogram) {
+        auto total = 0.0;
+        for (std::size_t distance = 0; distance < histogram.size(); distance++) {
+            total += static_cast<double>(distance * histogram[distance]);
+        }
+        return keys == 0 ? 0.0 : total / static_cast<double>(keys);
+    };
+
+    auto p99 = std::size_t{0};
+    for (auto seen = std::size_t{0}; p99 < counts.size(); p99++) {
+        seen += counts[p99];
+        if (static_cast<double>(seen) >= 0.99 * static_cast<double>(keys)) {
+            break;
+        }
+    }
+
+    return {
+        .reduction = reduction,
+        .load_factor = load_factor,
+        .buckets = buckets,
+        .keys = keys,
+        .mean_distance = mean(counts),
+        .p99_distance = std::min(p99, counts.empty() ? 0 : counts.size() - 1),
+        .max_distance = counts.empty() ? 0 : counts.size() - 1,
+        .ideal_mean_distance = mean(ideal),
+        .ideal_max_distance = ideal.empty() ? 0 : ideal.size() - 1,
+        .distance_counts = std::move(counts),
+    };
+}
+
+template<typename Key, concepts::hash_function_object<Key> Hash>
+auto analyze_hash(std::span<const Key> keys, const Hash& hasher = Hash{}, const hash_analysis_options& options = {})
+    noexcept -> hash_report {
+    std::vector<std::size_t> hashes(keys.size());
+    for (std::size_t i = 0; i < keys.size(); i++) {
+        hashes[i] = hasher(keys[i]);
+    }
+
+    hash_report report{.keys = keys.size()};
+
+    auto sorted = hashes;
+    std::sort(sorted.begin(), sorted.end());
+    report.distinct_hashes = static_cast<std::size_t>(std::unique(sorted.begin(), sorted.end()) - sorted.begin());
+
+    if constexpr (detail::bit_flippable<Key>) {
+        report.avalanche = analyze_avalanche(keys, hasher, options.avalanche_keys);
+    }
+
+    for (const auto reduction : options.reductions) {
+        report.buckets.push_back(analyze_buckets(hashes, reduction));
+    }
+
+    for (const auto load_factor : options.load_factors) {
+        for (const auto reduction : options.reductions) {
+            report.probes.push_back(simulate_probes(hashes, load_factor, reduction));
+        }
+    }
+
+    return report;
+}
+} // namespace rjh
+
+#endif // #ifndef RJH_HASH_ANALYZER_HPP
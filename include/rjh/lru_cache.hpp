@@ -0,0 +1,220 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RJH_LRU_CACHE_HPP
+#define RJH_LRU_CACHE_HPP
+
+#include "detail/hash_table.hpp"
+#include "detail/pair_hash.hpp"
+#include "hash.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace rjh {
+// A fixed capacity cache that evicts the least recently used entry. Every entry keeps its value and the index of its
+// recency node inline in the hash table. The recency nodes live in an array allocated once at construction, so
+// lookups probe the table once and eviction never allocates.
+template<
+    typename Key,
+    typename Value,
+    concepts::hash_function_object<Key> Hash = rjh::hash<Key>,
+    concepts::key_equal_function_object<Key> KeyEqual = std::equal_to<Key>
+>
+class lru_cache {
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using size_type = std::size_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+
+    explicit lru_cache(size_type capacity)
+        : m_nodes(std::max<size_type>(capacity, 1)) {
+        m_hash_table.reserve(m_nodes.size());
+        reset_nodes();
+    }
+
+    // Returns the cached value and marks it as most recently used, or nullptr on a miss. The pointer is invalidated
+    // by the next modification of the cache.
+    auto get(const key_type& key) noexcept -> mapped_type* {
+        const auto it = m_hash_table.find(key);
+        if (it == m_hash_table.end()) {
+            return nullptr;
+        }
+
+        auto& entry = it->key.second;
+        move_to_front(entry.node);
+        return &entry.value;
+    }
+
+    // Returns the cached value without affecting recency, or nullptr on a miss.
+    auto peek(const key_type& key) const noexcept -> const mapped_type* {
+        const auto it = m_hash_table.find(key);
+        return it == m_hash_table.end() ? nullptr : &it->key.second.value;
+    }
+
+    // Inserts or assigns value and marks it as most recently used, evicting the least recently used entry if the
+    // cache is full. A miss hashes and probes the key once: the eviction runs after the probe, and insertion places
+    // the entry from the hash the probe computed.
+    template<typename V> requires std::assignable_from<mapped_type&, V&&>
+    auto put(const key_type& key, V&& value) noexcept -> mapped_type& {
+        auto node = s_null;
+        const auto [it, inserted] = m_hash_table.find_or_insert(key, [&] {
+            if (m_free == s_null) {
+                evict();
+            }
+
+            node = m_free;
+            m_free = m_nodes[node].next;
+            return table_value{key, entry_type{.value = mapped_type(std::forward<V>(value)), .node = node}};
+        });
+
+        auto& entry = it->key.second;
+        if (inserted) {
+            m_nodes[node].hash = it->hash;
+            link_front(node);
+        } else {
+            entry.value = std::forward<V>(value);
+            move_to_front(entry.node);
+        }
+        return entry.value;
+    }
+
+    auto erase(const key_type& key) noexcept -> bool {
+        const auto it = m_hash_table.find(key);
+        if (it == m_hash_table.end()) {
+            return false;
+        }
+
+        const auto node = it->key.second.node;
+        m_hash_table.remove_with_hash(it->hash, [node](const table_value& pair) { return pair.second.node == node; });
+        release(node);
+        return true;
+    }
+
+    auto contains(const key_type& key) const noexcept -> bool {
+        return m_hash_table.contains(key);
+    }
+
+    auto clear() noexcept -> void {
+        m_hash_table.clear();
+        reset_nodes();
+    }
+
+    [[nodiscard]] auto empty() const noexcept -> bool {
+        return m_hash_table.empty();
+    }
+
+    [[nodiscard]] auto size() const noexcept -> size_type {
+        return m_hash_table.size();
+    }
+
+    [[nodiscard]] auto capacity() const noexcept -> size_type {
+        return m_nodes.size();
+    }
+
+private:
+    using node_index = std::uint32_t;
+    static constexpr node_index s_null = ~node_index{0};
+
+    struct entry_type {
+        mapped_type value{};
+        node_index node{s_null};
+    };
+
+    struct node_type {
+        std::size_t hash{};
+        node_index previous{s_null};
+        node_index next{s_null};
+    };
+
+    using table_value = std::pair<key_type, entry_type>;
+    using pair_hash = detail::pair_hash<key_type, entry_type, hasher>;
+    using pair_key_equal = detail::pair_key_equal<key_type, entry_type, key_equal>;
+
+    auto evict() noexcept -> void {
+        const auto node = m_tail;
+        m_hash_table.remove_with_hash(m_nodes[node].hash, [node](const table_value& pair) {
+            return pair.second.node == node;
+        });
+        release(node);
+    }
+
+    auto release(node_index node) noexcept -> void {
+        unlink(node);
+        m_nodes[node].next = m_free;
+        m_free = node;
+    }
+
+    auto move_to_front(node_index node) noexcept -> void {
+        if (node != m_head) {
+            unlink(node);
+            link_front(node);
+        }
+    }
+
+    auto link_front(node_index node) noexcept -> void {
+        m_nodes[node].previous = s_null;
+        m_nodes[node].next = m_head;
+        if (m_head != s_null) {
+            m_nodes[m_head].previous = node;
+        }
+        m_head = node;
+        if (m_tail == s_null) {
+            m_tail = node;
+        }
+    }
+
+    auto unlink(node_index node) noexcept -> void {
+        const auto previous = m_nodes[node].previous;
+        const auto next = m_nodes[node].next;
+        if (previous != s_null) {
+            m_nodes[previous].next = next;
+        } else {
+            m_head = next;
+        }
+
+        if (next != s_null) {
+            m_nodes[next].previous = previous;
+        } else {
+            m_tail = previous;
+        }
+    }
+
+    auto reset_nodes() noexcept -> void {
+        for (size_type i = 0; i < m_nodes.size(); i++) {
+            m_nodes[i] = {.next = i + 1 == m_nodes.size() ? s_null : static_cast<node_index>(i + 1)};
+        }
+
+        m_head = s_null;
+        m_tail = s_null;
+        m_free = 0;
+    }
+
+    detail::hash_table<table_value, pair_hash, pair_key_equal> m_hash_table;
+    std::vector<node_type> m_nodes;
+    node_index m_head{s_null};
+    node_index m_tail{s_null};
+    node_index m_free{0};
+}; // class lru_cache
+} // namespace rjh
+
+#endif // #ifndef RJH_LRU_CACHE_HPP
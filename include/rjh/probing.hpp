@@ -0,0 +1,44 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RJH_PROBING_HPP
+#define RJH_PROBING_HPP
+
+#include "detail/hash_table.hpp"
+#include "detail/swiss_table.hpp"
+
+namespace rjh {
+// Probing policies pick the table engine behind unordered_set and unordered_map. Each one names a table template with
+// the interface of detail::hash_table, so the containers behave the same whichever is chosen and only their
+// performance differs.
+
+// Linear probing with Robin Hood displacement and backward-shift removal. Probe sequences stay short and sorted by
+// distance, so misses stop early, and removal leaves no markers behind. The default.
+struct robin_hood_probing {
+    template<typename Key, typename Hash, typename KeyEqual, bool Multi, bool Generational>
+    using table = detail::hash_table<Key, Hash, KeyEqual, Multi, Generational>;
+};
+
+// Quadratic probing over groups of sixteen one-byte hash tags, in the style of Abseil's Swiss tables. Runs to a load
+// factor of 7/8 rather than 3/4, compares few keys on a miss, and never moves an entry after inserting it, which suits
+// large keys and erase-heavy workloads. Duplicate keys are not supported. Generational only skips destroying keys on
+// clear(), which still resets a control byte per bucket.
+struct swiss_probing {
+    template<typename Key, typename Hash, typename KeyEqual, bool Multi, bool Generational> requires (!Multi)
+    using table = detail::swiss_table<Key, Hash, KeyEqual, Generational>;
+};
+} // namespace rjh
+
+#endif // #ifndef RJH_PROBING_HPP
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RJH_SENTINEL_UNORDERED_SET_HPP
+#define RJH_SENTINEL_UNORDERED_SET_HPP
+
+#include "concepts.hpp"
+#include "detail/sentinel_hash_table.hpp"
+#include "hash.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+namespace rjh {
+// A set of integer or pointer keys where one key value, Empty, is reserved to mark empty buckets. Buckets are the bare
+// keys, so a set of std::uint32_t uses 4 bytes per slot. Empty defaults to the largest integer or to nullptr, and
+// inserting it fails.
+template<
+    concepts::sentinel_key Key,
+    Key Empty = detail::default_sentinel<Key>(),
+    concepts::hash_function_object<Key> Hash = rjh::hash<Key>,
+    concepts::key_equal_function_object<Key> KeyEqual = std::equal_to<Key>
+>
+class sentinel_unordered_set {
+    using hash_table = detail::sentinel_hash_table<Key, Empty, void, Hash, KeyEqual>;
+
+public:
+    using value_type = Key;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using iterator = typename hash_table::const_iterator;
+    using const_iterator = typename hash_table::const_iterator;
+
+    static constexpr value_type empty_key = Empty;
+
+    auto insert(value_type key) noexcept -> std::pair<iterator, bool> {
+        auto [it, inserted] = m_hash_table.insert(key);
+        return {const_iterator{it.operator->(), m_hash_table.end().operator->()}, inserted};
+    }
+
+    auto find(value_type key) const noexcept -> const_iterator {
+        return m_hash_table.find(key);
+    }
+
+    auto contains(value_type key) const noexcept -> bool {
+        return m_hash_table.contains(key);
+    }
+
+    auto erase(value_type key) noexcept -> bool {
+        return m_hash_table.remove(key);
+    }
+
+    template<typename Predicate> requires std::predicate<Predicate&, const_reference>
+    auto erase_if(Predicate predicate) noexcept -> size_type {
+        return m_hash_table.erase_if(std::move(predicate));
+    }
+
+    auto reserve(size_type count) noexcept -> void {
+        m_hash_table.reserve(count);
+    }
+
+    auto clear() noexcept -> void {
+        m_hash_table.clear();
+    }
+
+    [[nodiscard]] auto empty() const noexcept -> bool {
+        return m_hash_table.empty();
+    }
+
+    [[nodiscard]] auto capacity() const noexcept -> size_type {
+        return m_hash_table.capacity();
+    }
+
+    [[nodiscard]] auto size() const noexcept -> size_type {
+        return m_hash_table.size();
+    }
+
+    [[nodiscard]] auto begin() const noexcept -> const_iterator {
+        return m_hash_table.begin();
+    }
+
+    [[nodiscard]] auto cbegin() const noexcept -> const_iterator {
+        return m_hash_table.begin();
+    }
+
+    [[nodiscard]] auto end() const noexcept -> const_iterator {
+        return m_hash_table.end();
+    }
+
+    [[nodiscard]] auto cend() const noexcept -> const_iterator {
+        return m_hash_table.end();
+    }
+
+private:
+    hash_table m_hash_table;
+}; // class sentinel_unordered_set
+} // namespace rjh
+
+#endif // #ifndef RJH_SENTINEL_UNORDERED_SET_HPP
@@ -0,0 +1,262 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RJH_SNAPSHOT_UNORDERED_MAP_HPP
+#define RJH_SNAPSHOT_UNORDERED_MAP_HPP
+
+#include "concepts.hpp"
+#include "detail/cow_hash_table.hpp"
+#include "hash.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+namespace rjh {
+// A map that can hand out consistent read-only snapshots of itself while it keeps taking writes. The buckets are held
+// in reference-counted chunks, so snapshot() and the copy constructor only copy chunk pointers, and a write copies the
+// chunk it lands in only if a snapshot still shares it. Keeping a snapshot alive therefore costs memory in proportion
+// to the chunks written since, not to the size of the map.
+//
+// One thread may write to the map while any number of threads read snapshots of it. Snapshots are immutable and can
+// be copied, read and destroyed on any thread. Entries are only reachable through const iterators, since their bucket
+// may be shared; change values with insert_or_assign or upsert_with.
+template<
+    typename Key,
+    typename Value,
+    concepts::hash_function_object<Key> Hash = rjh::hash<Key>,
+    concepts::key_equal_function_object<Key> KeyEqual = std::equal_to<Key>
+>
+class snapshot_unordered_map {
+    using hash_table = detail::cow_hash_table<Key, Value, Hash, KeyEqual>;
+
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<key_type, mapped_type>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    class const_iterator final {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type  = difference_type;
+        using value_type = const snapshot_unordered_map::value_type;
+        using pointer = value_type*;
+        using reference = value_type&;
+        using table_iterator = typename hash_table::const_iterator;
+
+        const_iterator(table_iterator it) : m_iterator{it} {
+
+        }
+
+        auto operator*() const noexcept -> reference {
+            return *m_iterator;
+        }
+
+        auto operator->() const noexcept -> pointer {
+            return m_iterator.operator->();
+        }
+
+        auto key() const noexcept -> const key_type& {
+            return m_iterator->first;
+        }
+
+        auto value() const noexcept -> const mapped_type& {
+            return m_iterator->second;
+        }
+
+        auto operator++() noexcept -> const_iterator& {
+            m_iterator++;
+            return *this;
+        }
+
+        auto operator++(int) noexcept -> const_iterator {
+            auto temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        friend auto operator==(const const_iterator& a, const const_iterator& b) noexcept -> bool {
+            return a.m_iterator == b.m_iterator;
+        }
+
+        friend auto operator!=(const const_iterator& a, const const_iterator& b) noexcept -> bool {
+            return a.m_iterator != b.m_iterator;
+        }
+
+    private:
+        table_iterator m_iterator;
+    };
+
+    using iterator = const_iterator;
+
+    // The map's contents at the moment snapshot() was called. Later writes to the map do not show through.
+    class snapshot_type final {
+    public:
+        [[nodiscard]] auto find(const key_type& key) const noexcept -> const_iterator {
+            return m_view.find(key);
+        }
+
+        [[nodiscard]] auto contains(const key_type& key) const noexcept -> bool {
+            return m_view.contains(key);
+        }
+
+        [[nodiscard]] auto empty() const noexcept -> bool {
+            return size() == 0;
+        }
+
+        [[nodiscard]] auto size() const noexcept -> size_type {
+            return m_view.size();
+        }
+
+        [[nodiscard]] auto begin() const noexcept -> const_iterator {
+            return m_view.begin();
+        }
+
+        [[nodiscard]] auto cbegin() const noexcept -> const_iterator {
+            return m_view.begin();
+        }
+
+        [[nodiscard]] auto end() const noexcept -> const_iterator {
+            return m_view.end();
+        }
+
+        [[nodiscard]] auto cend() const noexcept -> const_iterator {
+            return m_view.end();
+        }
+
+    private:
+        friend class snapshot_unordered_map;
+
+        snapshot_type(typename hash_table::view&& view) : m_view{std::move(view)} {
+
+        }
+
+        typename hash_table::view m_view;
+    };
+
+    // Leaves an existing entry with an equal key in place and returns it with false.
+    auto insert(const_reference pair) noexcept -> std::pair<iterator, bool> {
+        return m_hash_table.insert(value_type(pair));
+    }
+
+    auto insert(value_type&& pair) noexcept -> std::pair<iterator, bool> {
+        return m_hash_table.insert(std::move(pair));
+    }
+
+    template<typename Pair> requires std::constructible_from<value_type, Pair&&>
+    auto insert(Pair&& pair) noexcept -> std::pair<iterator, bool> {
+        return m_hash_table.insert(value_type(std::forward<Pair>(pair)));
+    }
+
+    // Inserts value under key, or assigns it to the existing entry. The bool is true if value was inserted.
+    template<typename V> requires std::constructible_from<mapped_type, V&&> && std::assignable_from<mapped_type&, V&&>
+    auto insert_or_assign(const key_type& key, V&& value) noexcept -> std::pair<iterator, bool> {
+        // Only one of the two lambdas runs, so value is forwarded at most once.
+        return m_hash_table.upsert(
+            key,
+            [&key, &value] { return value_type{key, mapped_type(std::forward<V>(value))}; },
+            [&value](mapped_type& existing) { existing = std::forward<V>(value); }
+        );
+    }
+
+    // Inserts value under key if key is absent, otherwise calls op(existing value, value). The bool is true if value
+    // was inserted.
+    template<typename V, typename Op>
+        requires std::constructible_from<mapped_type, V&&> && std::invocable<Op&, mapped_type&, V&&>
+    auto upsert_with(const key_type& key, V&& value, Op op) noexcept -> std::pair<iterator, bool> {
+        return m_hash_table.upsert(
+            key,
+            [&key, &value] { return value_type{key, mapped_type(std::forward<V>(value))}; },
+            [&value, &op](mapped_type& existing) { op(existing, std::forward<V>(value)); }
+        );
+    }
+
+    auto find(const key_type& key) const noexcept -> const_iterator {
+        return m_hash_table.find(key);
+    }
+
+    auto contains(const key_type& key) const noexcept -> bool {
+        return m_hash_table.contains(key);
+    }
+
+    auto erase(const key_type& key) noexcept -> bool {
+        return m_hash_table.remove(key);
+    }
+
+    template<typename Predicate> requires std::predicate<Predicate&, const_reference>
+    auto erase_if(Predicate predicate) noexcept -> size_type {
+        return m_hash_table.erase_if(std::move(predicate));
+    }
+
+    // O(chunks). The snapshot stays valid, and unchanged, after the map is modified or destroyed.
+    [[nodiscard]] auto snapshot() const noexcept -> snapshot_type {
+        return m_hash_table.snapshot();
+    }
+
+    // How many bucket chunks the map still shares with snapshots or copies of it.
+    [[nodiscard]] auto shared_chunks() const noexcept -> size_type {
+        return m_hash_table.shared_chunks();
+    }
+
+    auto reserve(size_type count) noexcept -> void {
+        m_hash_table.reserve(count);
+    }
+
+    auto clear() noexcept -> void {
+        m_hash_table.clear();
+    }
+
+    [[nodiscard]] auto empty() const noexcept -> bool {
+        return m_hash_table.empty();
+    }
+
+    [[nodiscard]] auto capacity() const noexcept -> size_type {
+        return m_hash_table.capacity();
+    }
+
+    [[nodiscard]] auto size() const noexcept -> size_type {
+        return m_hash_table.size();
+    }
+
+    [[nodiscard]] auto begin() const noexcept -> const_iterator {
+        return m_hash_table.begin();
+    }
+
+    [[nodiscard]] auto cbegin() const noexcept -> const_iterator {
+        return m_hash_table.begin();
+    }
+
+    [[nodiscard]] auto end() const noexcept -> const_iterator {
+        return m_hash_table.end();
+    }
+
+    [[nodiscard]] auto cend() const noexcept -> const_iterator {
+        return m_hash_table.end();
+    }
+
+private:
+    hash_table m_hash_table;
+}; // class snapshot_unordered_map
+} // namespace rjh
+
+#endif // #ifndef RJH_SNAPSHOT_UNORDERED_MAP_HPP
@@ -0,0 +1,204 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RJH_STATIC_UNORDERED_MAP_HPP
+#define RJH_STATIC_UNORDERED_MAP_HPP
+
+#include "concepts.hpp"
+#include "detail/static_hash_table.hpp"
+#include "hash.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace rjh {
+// A map with room for Capacity entries stored inline. It never allocates or rehashes, so every operation runs in
+// bounded time. insert returns end() and false once the map is full, or in the rare case that placing the entry
+// would push another more than probe_limit buckets from its home. The buckets live inside the object, so large maps
+// belong in static or heap storage rather than on the stack. Keys and values must be default constructible.
+template<
+    std::default_initializable Key,
+    std::default_initializable Value,
+    std::size_t Capacity,
+    concepts::hash_function_object<Key> Hash = rjh::hash<Key>,
+    concepts::key_equal_function_object<Key> KeyEqual = std::equal_to<Key>
+>
+class static_unordered_map {
+    using hash_table = detail::static_hash_table<Key, Value, Capacity, Hash, KeyEqual>;
+
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<key_type, mapped_type>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    static constexpr size_type probe_limit = hash_table::probe_limit;
+
+    template<typename T, typename It>
+    class raw_iterator final {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type  = difference_type;
+        using value_type = T;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+        using mapped_type = std::conditional_t<std::is_const_v<T>, const mapped_type, mapped_type>;
+        using table_iterator = It;
+
+        raw_iterator(table_iterator it) : m_iterator{it} {
+
+        }
+
+        auto operator*() const noexcept -> reference {
+            return *m_iterator;
+        }
+
+        auto operator->() const noexcept -> pointer {
+            return m_iterator.operator->();
+        }
+
+        auto key() const noexcept -> const key_type& {
+            return m_iterator->first;
+        }
+
+        auto value() const noexcept -> mapped_type& {
+            return m_iterator->second;
+        }
+
+        auto operator++() noexcept -> raw_iterator& {
+            m_iterator++;
+            return *this;
+        }
+
+        auto operator++(int) noexcept -> raw_iterator {
+            auto temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        friend auto operator==(const raw_iterator& a, const raw_iterator& b) noexcept -> bool {
+            return a.m_iterator == b.m_iterator;
+        }
+
+        friend auto operator!=(const raw_iterator& a, const raw_iterator& b) noexcept -> bool {
+            return a.m_iterator != b.m_iterator;
+        }
+
+    private:
+        table_iterator m_iterator;
+    };
+
+    using iterator = raw_iterator<value_type, typename hash_table::iterator>;
+    using const_iterator = raw_iterator<const value_type, typename hash_table::const_iterator>;
+
+    auto insert(const_reference pair) noexcept -> std::pair<iterator, bool>
+        requires std::is_nothrow_copy_constructible_v<value_type> {
+        return m_hash_table.insert(value_type(pair));
+    }
+
+    auto insert(value_type&& pair) noexcept -> std::pair<iterator, bool> {
+        return m_hash_table.insert(std::move(pair));
+    }
+
+    template<typename Pair> requires std::is_nothrow_constructible_v<value_type, Pair&&>
+    auto insert(Pair&& pair) noexcept -> std::pair<iterator, bool> {
+        return m_hash_table.insert(value_type(std::forward<Pair>(pair)));
+    }
+
+    auto find(const key_type& key) noexcept -> iterator {
+        return m_hash_table.find(key);
+    }
+
+    auto find(const key_type& key) const noexcept -> const_iterator {
+        return m_hash_table.find(key);
+    }
+
+    auto contains(const key_type& key) const noexcept -> bool {
+        return m_hash_table.contains(key);
+    }
+
+    auto erase(const key_type& key) noexcept -> bool {
+        return m_hash_table.remove(key);
+    }
+
+    template<typename Predicate> requires std::predicate<Predicate&, const_reference>
+    auto erase_if(Predicate predicate) noexcept -> size_type {
+        return m_hash_table.erase_if(std::move(predicate));
+    }
+
+    auto clear() noexcept -> void {
+        m_hash_table.clear();
+    }
+
+    [[nodiscard]] auto empty() const noexcept -> bool {
+        return m_hash_table.empty();
+    }
+
+    // The furthest any entry sits from its home bucket.
+    [[nodiscard]] auto longest_probe() const noexcept -> size_type {
+        return m_hash_table.longest_probe();
+    }
+
+    [[nodiscard]] static constexpr auto capacity() noexcept -> size_type {
+        return hash_table::capacity();
+    }
+
+    [[nodiscard]] static constexpr auto bucket_count() noexcept -> size_type {
+        return hash_table::bucket_count();
+    }
+
+    [[nodiscard]] auto size() const noexcept -> size_type {
+        return m_hash_table.size();
+    }
+
+    [[nodiscard]] auto begin() noexcept -> iterator {
+        return m_hash_table.begin();
+    }
+
+    [[nodiscard]] auto begin() const noexcept -> const_iterator {
+        return m_hash_table.begin();
+    }
+
+    [[nodiscard]] auto cbegin() const noexcept -> const_iterator {
+        return m_hash_table.begin();
+    }
+
+    [[nodiscard]] auto end() noexcept -> iterator {
+        return m_hash_table.end();
+    }
+
+    [[nodiscard]] auto end() const noexcept -> const_iterator {
+        return m_hash_table.end();
+    }
+
+    [[nodiscard]] auto cend() const noexcept -> const_iterator {
+        return m_hash_table.end();
+    }
+
+private:
+    hash_table m_hash_table;
+}; // class static_unordered_map
+} // namespace rjh
+
+#endif // #ifndef RJH_STATIC_UNORDERED_MAP_HPP
@@ -0,0 +1,128 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RJH_STATIC_UNORDERED_SET_HPP
+#define RJH_STATIC_UNORDERED_SET_HPP
+
+#include "concepts.hpp"
+#include "detail/static_hash_table.hpp"
+#include "hash.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace rjh {
+// A set with room for Capacity keys stored inline. It never allocates or rehashes, so every operation runs in
+// bounded time. insert returns end() and false once the set is full, or in the rare case that placing the key
+// would push an entry more than probe_limit buckets from its home. The buckets live inside the object, so large
+// sets belong in static or heap storage rather than on the stack. Keys must be default constructible.
+template<
+    std::default_initializable Key,
+    std::size_t Capacity,
+    concepts::hash_function_object<Key> Hash = rjh::hash<Key>,
+    concepts::key_equal_function_object<Key> KeyEqual = std::equal_to<Key>
+>
+class static_unordered_set {
+    using hash_table = detail::static_hash_table<Key, void, Capacity, Hash, KeyEqual>;
+
+public:
+    using value_type = Key;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using iterator = typename hash_table::const_iterator;
+    using const_iterator = typename hash_table::const_iterator;
+
+    static constexpr size_type probe_limit = hash_table::probe_limit;
+
+    auto insert(const_reference key) noexcept -> std::pair<iterator, bool>
+        requires std::is_nothrow_copy_constructible_v<value_type> {
+        return m_hash_table.insert(value_type(key));
+    }
+
+    auto insert(value_type&& key) noexcept -> std::pair<iterator, bool> {
+        return m_hash_table.insert(std::move(key));
+    }
+
+    auto find(const_reference key) const noexcept -> const_iterator {
+        return m_hash_table.find(key);
+    }
+
+    auto contains(const_reference key) const noexcept -> bool {
+        return m_hash_table.contains(key);
+    }
+
+    auto erase(const_reference key) noexcept -> bool {
+        return m_hash_table.remove(key);
+    }
+
+    template<typename Predicate> requires std::predicate<Predicate&, const_reference>
+    auto erase_if(Predicate predicate) noexcept -> size_type {
+        return m_hash_table.erase_if(std::move(predicate));
+    }
+
+    auto clear() noexcept -> void {
+        m_hash_table.clear();
+    }
+
+    // The furthest any key sits from its home bucket.
+    [[nodiscard]] auto longest_probe() const noexcept -> size_type {
+        return m_hash_table.longest_probe();
+    }
+
+    [[nodiscard]] auto empty() const noexcept -> bool {
+        return m_hash_table.empty();
+    }
+
+    [[nodiscard]] static constexpr auto capacity() noexcept -> size_type {
+        return hash_table::capacity();
+    }
+
+    [[nodiscard]] static constexpr auto bucket_count() noexcept -> size_type {
+        return hash_table::bucket_count();
+    }
+
+    [[nodiscard]] auto size() const noexcept -> size_type {
+        return m_hash_table.size();
+    }
+
+    [[nodiscard]] auto begin() const noexcept -> const_iterator {
+        return m_hash_table.begin();
+    }
+
+    [[nodiscard]] auto cbegin() const noexcept -> const_iterator {
+        return m_hash_table.begin();
+    }
+
+    [[nodiscard]] auto end() const noexcept -> const_iterator {
+        return m_hash_table.end();
+    }
+
+    [[nodiscard]] auto cend() const noexcept -> const_iterator {
+        return m_hash_table.end();
+    }
+
+private:
+    hash_table m_hash_table;
+}; // class static_unordered_set
+} // namespace rjh
+
+#endif // #ifndef RJH_STATIC_UNORDERED_SET_HPP
@@ -0,0 +1,252 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RJH_STRING_MAP_HPP
+#define RJH_STRING_MAP_HPP
+
+#include "concepts.hpp"
+#include "detail/hash_table.hpp"
+#include "detail/pair_hash.hpp"
+#include "detail/string_arena.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace rjh {
+// A map from strings to Value that copies each key's bytes into an append-only arena owned by the map, so a bucket
+// holds only a view of the key next to its cached hash. Lookups take std::string_view, so std::string, string
+// literals and const char* keys need no transparent hasher and no temporary strings. Erasing a key does not return
+// its bytes to the arena; shrink_to_fit, clear and erase_if or retain with shrink set do.
+template<typename Value, concepts::hash_function_object<std::string_view> Hash = std::hash<std::string_view>>
+class string_map {
+public:
+    using key_type = std::string_view;
+    using mapped_type = Value;
+    using value_type = std::pair<key_type, mapped_type>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+private:
+    using pair_hash = detail::pair_hash<key_type, mapped_type, hasher>;
+    using pair_key_equal = detail::pair_key_equal<key_type, mapped_type, std::equal_to<key_type>>;
+
+    using hash_table = detail::hash_table<value_type, pair_hash, pair_key_equal>;
+
+public:
+    template<typename T, typename It>
+    class raw_iterator final {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type  = difference_type;
+        using value_type = T;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+        using mapped_type = std::conditional_t<std::is_const_v<T>, const mapped_type, mapped_type>;
+        using mapped_type_reference = mapped_type&;
+        using table_iterator = It;
+
+        raw_iterator(table_iterator it) : m_iterator{it} {
+
+        }
+
+        auto operator*() const noexcept -> reference {
+            return m_iterator->key;
+        }
+
+        auto operator->() const noexcept -> pointer {
+            return &m_iterator->key;
+        }
+
+        auto key() const noexcept -> key_type {
+            return m_iterator->key.first;
+        }
+
+        auto value() const noexcept -> mapped_type_reference {
+            return m_iterator->key.second;
+        }
+
+        auto operator++() noexcept -> raw_iterator& {
+            m_iterator++;
+            return *this;
+        }
+
+        auto operator++(int) noexcept -> raw_iterator {
+            auto temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        friend auto operator==(const raw_iterator& a, const raw_iterator& b) noexcept -> bool {
+            return a.m_iterator == b.m_iterator;
+        }
+
+        friend auto operator!=(const raw_iterator& a, const raw_iterator& b) noexcept -> bool {
+            return a.m_iterator != b.m_iterator;
+        }
+
+    private:
+        table_iterator m_iterator;
+    };
+
+    using iterator = raw_iterator<value_type, typename hash_table::iterator>;
+    using const_iterator = raw_iterator<const value_type, typename hash_table::const_iterator>;
+
+    string_map() = default;
+    ~string_map() = default;
+
+    string_map(const string_map& other) : m_hash_table{other.m_hash_table} {
+        store_keys();
+    }
+
+    string_map(string_map&&) = default;
+
+    string_map& operator=(const string_map& other) {
+        if (this != &other) {
+            m_hash_table = other.m_hash_table;
+            m_arena.clear();
+            store_keys();
+        }
+        return *this;
+    }
+
+    string_map& operator=(string_map&&) = default;
+
+    // Copies key into the arena only if it is not already present.
+    template<typename V> requires std::constructible_from<mapped_type, V&&>
+    auto insert(key_type key, V&& value) noexcept -> std::pair<iterator, bool> {
+        return m_hash_table.find_or_insert(key, [&] {
+            return value_type{m_arena.store(key), mapped_type(std::forward<V>(value))};
+        });
+    }
+
+    auto find(key_type key) noexcept -> iterator {
+        return m_hash_table.find(key);
+    }
+
+    auto find(key_type key) const noexcept -> const_iterator {
+        return m_hash_table.find(key);
+    }
+
+    auto contains(key_type key) const noexcept -> bool {
+        return m_hash_table.contains(key);
+    }
+
+    auto erase(key_type key) noexcept -> bool {
+        return m_hash_table.remove(key);
+    }
+
+    // With shrink set, also repacks the arena as shrink_to_fit does.
+    template<typename Predicate> requires std::predicate<Predicate&, const_reference>
+    auto erase_if(Predicate predicate, bool shrink = false) noexcept -> size_type {
+        const auto removed = m_hash_table.erase_if(std::move(predicate), shrink);
+        if (shrink) {
+            repack_keys();
+        }
+        return removed;
+    }
+
+    template<typename Predicate> requires std::predicate<Predicate&, const_reference>
+    auto retain(Predicate predicate, bool shrink = false) noexcept -> size_type {
+        const auto removed = m_hash_table.retain(std::move(predicate), shrink);
+        if (shrink) {
+            repack_keys();
+        }
+        return removed;
+    }
+
+    auto reserve(size_type count) noexcept -> void {
+        m_hash_table.reserve(count);
+    }
+
+    // Also repacks the keys still in the map into a fresh arena, releasing the bytes of erased keys.
+    auto shrink_to_fit() noexcept -> void {
+        m_hash_table.shrink_to_fit();
+        repack_keys();
+    }
+
+    auto clear() noexcept -> void {
+        m_hash_table.clear();
+        m_arena.clear();
+    }
+
+    [[nodiscard]] auto empty() const noexcept -> bool {
+        return m_hash_table.empty();
+    }
+
+    [[nodiscard]] auto capacity() const noexcept -> size_type {
+        return m_hash_table.capacity();
+    }
+
+    [[nodiscard]] auto size() const noexcept -> size_type {
+        return m_hash_table.size();
+    }
+
+    // Bytes of key storage held by the arena, including those of erased keys.
+    [[nodiscard]] auto key_bytes() const noexcept -> size_type {
+        return m_arena.used();
+    }
+
+    [[nodiscard]] auto begin() noexcept -> iterator {
+        return m_hash_table.begin();
+    }
+
+    [[nodiscard]] auto begin() const noexcept -> const_iterator {
+        return m_hash_table.begin();
+    }
+
+    [[nodiscard]] auto cbegin() const noexcept -> const_iterator {
+        return m_hash_table.cbegin();
+    }
+
+    [[nodiscard]] auto end() noexcept -> iterator {
+        return m_hash_table.end();
+    }
+
+    [[nodiscard]] auto end() const noexcept -> const_iterator {
+        return m_hash_table.end();
+    }
+
+    [[nodiscard]] auto cend() const noexcept -> const_iterator {
+        return m_hash_table.cend();
+    }
+
+private:
+    // Points every key at a copy in this map's arena. Views and hashes are unchanged, so no rehash is needed.
+    auto store_keys() noexcept -> void {
+        for (auto& entry : m_hash_table) {
+            entry.key.first = m_arena.store(entry.key.first);
+        }
+    }
+
+    // Copies the keys still in the map into a fresh arena and frees the old one along with the bytes of erased keys.
+    auto repack_keys() noexcept -> void {
+        const auto old_arena = std::move(m_arena);
+        store_keys();
+    }
+
+    hash_table m_hash_table;
+    detail::string_arena m_arena;
+}; // class string_map
+} // namespace rjh
+
+#endif // #ifndef RJH_STRING_MAP_HPP
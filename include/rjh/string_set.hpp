@@ -0,0 +1,227 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RJH_STRING_SET_HPP
+#define RJH_STRING_SET_HPP
+
+#include "concepts.hpp"
+#include "detail/hash_table.hpp"
+#include "detail/string_arena.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <string_view>
+#include <utility>
+
+namespace rjh {
+// A set of strings whose bytes live in an append-only arena owned by the set, see string_map.
+template<concepts::hash_function_object<std::string_view> Hash = std::hash<std::string_view>>
+class string_set {
+public:
+    using value_type = std::string_view;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+private:
+    using hash_table = detail::hash_table<value_type, hasher, std::equal_to<value_type>>;
+
+public:
+    template<typename It>
+    class raw_iterator final {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type  = difference_type;
+        using value_type = std::string_view;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+        using table_iterator = It;
+
+        raw_iterator(table_iterator it) : m_iterator{it} {
+
+        }
+
+        auto operator*() const noexcept -> reference {
+            return m_iterator->key;
+        }
+
+        auto operator->() const noexcept -> pointer {
+            return &m_iterator->key;
+        }
+
+        auto operator++() noexcept -> raw_iterator& {
+            m_iterator++;
+            return *this;
+        }
+
+        auto operator++(int) noexcept -> raw_iterator {
+            auto temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        friend auto operator==(const raw_iterator& a, const raw_iterator& b) noexcept -> bool {
+            return a.m_iterator == b.m_iterator;
+        }
+
+        friend auto operator!=(const raw_iterator& a, const raw_iterator& b) noexcept -> bool {
+            return a.m_iterator != b.m_iterator;
+        }
+
+    private:
+        table_iterator m_iterator;
+    };
+
+    using iterator = raw_iterator<typename hash_table::iterator>;
+    using const_iterator = raw_iterator<typename hash_table::const_iterator>;
+
+    string_set() = default;
+    ~string_set() = default;
+
+    string_set(const string_set& other) : m_hash_table{other.m_hash_table} {
+        store_keys();
+    }
+
+    string_set(string_set&&) = default;
+
+    string_set& operator=(const string_set& other) {
+        if (this != &other) {
+            m_hash_table = other.m_hash_table;
+            m_arena.clear();
+            store_keys();
+        }
+        return *this;
+    }
+
+    string_set& operator=(string_set&&) = default;
+
+    // Copies key into the arena only if it is not already present.
+    auto insert(value_type key) noexcept -> std::pair<iterator, bool> {
+        return m_hash_table.find_or_insert(key, [&] { return m_arena.store(key); });
+    }
+
+    auto find(value_type key) noexcept -> iterator {
+        return m_hash_table.find(key);
+    }
+
+    auto find(value_type key) const noexcept -> const_iterator {
+        return m_hash_table.find(key);
+    }
+
+    auto contains(value_type key) const noexcept -> bool {
+        return m_hash_table.contains(key);
+    }
+
+    auto erase(value_type key) noexcept -> bool {
+        return m_hash_table.remove(key);
+    }
+
+    // With shrink set, also repacks the arena as shrink_to_fit does.
+    template<typename Predicate> requires std::predicate<Predicate&, const_reference>
+    auto erase_if(Predicate predicate, bool shrink = false) noexcept -> size_type {
+        const auto removed = m_hash_table.erase_if(std::move(predicate), shrink);
+        if (shrink) {
+            repack_keys();
+        }
+        return removed;
+    }
+
+    template<typename Predicate> requires std::predicate<Predicate&, const_reference>
+    auto retain(Predicate predicate, bool shrink = false) noexcept -> size_type {
+        const auto removed = m_hash_table.retain(std::move(predicate), shrink);
+        if (shrink) {
+            repack_keys();
+        }
+        return removed;
+    }
+
+    auto reserve(size_type count) noexcept -> void {
+        m_hash_table.reserve(count);
+    }
+
+    // Also repacks the strings still in the set into a fresh arena, releasing the bytes of erased strings.
+    auto shrink_to_fit() noexcept -> void {
+        m_hash_table.shrink_to_fit();
+        repack_keys();
+    }
+
+    auto clear() noexcept -> void {
+        m_hash_table.clear();
+        m_arena.clear();
+    }
+
+    [[nodiscard]] auto empty() const noexcept -> bool {
+        return m_hash_table.empty();
+    }
+
+    [[nodiscard]] auto capacity() const noexcept -> size_type {
+        return m_hash_table.capacity();
+    }
+
+    [[nodiscard]] auto size() const noexcept -> size_type {
+        return m_hash_table.size();
+    }
+
+    // Bytes of string storage held by the arena, including those of erased strings.
+    [[nodiscard]] auto key_bytes() const noexcept -> size_type {
+        return m_arena.used();
+    }
+
+    [[nodiscard]] auto begin() noexcept -> iterator {
+        return m_hash_table.begin();
+    }
+
+    [[nodiscard]] auto begin() const noexcept -> const_iterator {
+        return m_hash_table.begin();
+    }
+
+    [[nodiscard]] auto cbegin() const noexcept -> const_iterator {
+        return m_hash_table.cbegin();
+    }
+
+    [[nodiscard]] auto end() noexcept -> iterator {
+        return m_hash_table.end();
+    }
+
+    [[nodiscard]] auto end() const noexcept -> const_iterator {
+        return m_hash_table.end();
+    }
+
+    [[nodiscard]] auto cend() const noexcept -> const_iterator {
+        return m_hash_table.cend();
+    }
+
+private:
+    auto store_keys() noexcept -> void {
+        for (auto& entry : m_hash_table) {
+            entry.key = m_arena.store(entry.key);
+        }
+    }
+
+    auto repack_keys() noexcept -> void {
+        const auto old_arena = std::move(m_arena);
+        store_keys();
+    }
+
+    hash_table m_hash_table;
+    detail::string_arena m_arena;
+}; // class string_set
+} // namespace rjh
+
+#endif // #ifndef RJH_STRING_SET_HPP
@@ -16,19 +16,28 @@
 #ifndef RJH_UNORDERED_MAP_HPP
 #define RJH_UNORDERED_MAP_HPP
 
-#include "detail/hash_table.hpp"
+#include "detail/pair_hash.hpp"
+#include "hash.hpp"
+#include "probing.hpp"
 
+#include <concepts>
 #include <cstddef>
 #include <functional>
 #include <iterator>
+#include <span>
 #include <utility>
 
 namespace rjh {
+// With Generational set, clear() leaves cleared entries to be overwritten on reuse, see detail::hash_table for how.
+// Meant for scratch maps that are refilled and cleared repeatedly. Probing picks the table engine, such as
+// swiss_probing in place of the default Robin Hood table.
 template<
     typename Key,
     typename Value,
-    concepts::hash_function_object<Key> Hash = std::hash<Key>,
-    concepts::key_equal_function_object<Key> KeyEqual = std::equal_to<Key>
+    concepts::hash_function_object<Key> Hash = rjh::hash<Key>,
+    concepts::key_equal_function_object<Key> KeyEqual = std::equal_to<Key>,
+    bool Generational = false,
+    typename Probing = robin_hood_probing
 >
 class unordered_map {
 public:
@@ -45,70 +54,10 @@ public:
     static constexpr bool transparent_hash_eq = concepts::is_transparent<hasher> && concepts::is_transparent<key_equal>;
 
 private:
-    struct pair_hash {
-        using is_transparent = void;
+    using pair_hash = detail::pair_hash<key_type, mapped_type, hasher>;
+    using pair_key_equal = detail::pair_key_equal<key_type, mapped_type, key_equal>;
 
-        [[nodiscard]]
-        auto operator()(const_reference pair) const noexcept -> size_type {
-            return hasher{}(pair.first);
-        }
-
-        [[nodiscard]]
-        auto operator()(const key_type& key) const noexcept -> size_type {
-            return hasher{}(key);
-        }
-
-        template<typename K>
-        [[nodiscard]]
-        auto operator()(const K& key) const noexcept -> size_type {
-            return hasher{}(key);
-        }
-    };
-
-    struct pair_key_equal {
-        using is_transparent = void;
-
-        [[nodiscard]]
-        auto operator()(const_reference a, const_reference b) const noexcept -> bool {
-            return key_equal{}(a.first, b.first);
-        }
-
-        [[nodiscard]]
-        auto operator()(const_reference a, const key_type& b) const noexcept -> bool {
-            return key_equal{}(a.first, b);
-        }
-
-        [[nodiscard]]
-        auto operator()(const key_type& a, const_reference b) const noexcept -> bool {
-            return key_equal{}(a, b.first);
-        }
-
-        template<typename K>
-        [[nodiscard]]
-        auto operator()(const_reference a, const K& b) const noexcept -> bool {
-            return key_equal{}(a.first, b);
-        }
-
-        template<typename K>
-        [[nodiscard]]
-        auto operator()(const K& a, const_reference b) const noexcept -> bool {
-            return key_equal{}(a, b.first);
-        }
-
-        template<typename K>
-        [[nodiscard]]
-        auto operator()(const key_type& a, const K& b) const noexcept -> bool {
-            return key_equal{}(a, b);
-        }
-
-        template<typename K>
-        [[nodiscard]]
-        auto operator()(const K& a, const key_type& b) const noexcept -> bool {
-            return key_equal{}(a, b);
-        }
-    };
-
-    using hash_table = detail::hash_table<value_type, pair_hash, pair_key_equal>;
+    using hash_table = typename Probing::template table<value_type, pair_hash, pair_key_equal, false, Generational>;
 
 public:
 
@@ -176,6 +125,40 @@ public:
     using iterator = raw_iterator<value_type, typename hash_table::iterator>;
     using const_iterator = raw_iterator<const value_type, typename hash_table::const_iterator>;
 
+    class node_type final {
+    public:
+        node_type() = default;
+
+        [[nodiscard]] auto empty() const noexcept -> bool {
+            return m_node.empty();
+        }
+
+        explicit operator bool() const noexcept {
+            return !empty();
+        }
+
+        [[nodiscard]] auto key() const noexcept -> const key_type& {
+            return m_node.key().first;
+        }
+
+        [[nodiscard]] auto value() noexcept -> mapped_type& {
+            return m_node.key().second;
+        }
+
+        [[nodiscard]] auto value() const noexcept -> const mapped_type& {
+            return m_node.key().second;
+        }
+
+    private:
+        friend class unordered_map;
+
+        node_type(typename hash_table::node_handle&& node) : m_node{std::move(node)} {
+
+        }
+
+        typename hash_table::node_handle m_node;
+    };
+
     auto insert(const_reference pair) noexcept -> std::pair<iterator, bool> {
         return m_hash_table.insert(pair);
     }
@@ -189,6 +172,83 @@ public:
         return m_hash_table.insert(std::forward<Pair>(pair));
     }
 
+    auto insert(node_type&& node) noexcept -> std::pair<iterator, bool> {
+        return m_hash_table.insert(std::move(node.m_node));
+    }
+
+    // Inserts value under key if key is absent, otherwise calls op(existing value, value). Either way key is hashed
+    // once. The bool is true if value was inserted.
+    template<typename V, typename Op>
+        requires std::constructible_from<mapped_type, V&&> && std::invocable<Op&, mapped_type&, V&&>
+    auto upsert_with(const key_type& key, V&& value, Op op) noexcept -> std::pair<iterator, bool> {
+        auto result = m_hash_table.find_or_insert(key, [&key, &value] {
+            return value_type{key, mapped_type(std::forward<V>(value))};
+        });
+
+        if (!result.second) {
+            op(result.first->key.second, std::forward<V>(value));
+        }
+
+        return result;
+    }
+
+    // Group-by over a columnar batch: for each row, the first occurrence of keys[i] is inserted with values[i] as its
+    // accumulator, and later ones call op(accumulator, values[i]). values must be at least as long as keys. Suits
+    // sum, min and max.
+    template<typename V, typename Op>
+        requires std::constructible_from<mapped_type, const V&> && std::invocable<Op&, mapped_type&, const V&>
+    auto aggregate(std::span<const key_type> keys, std::span<const V> values, Op op) noexcept -> void {
+        m_hash_table.upsert_bulk(
+            keys,
+            [keys, values](size_type i) {
+                return value_type{keys[i], mapped_type(values[i])};
+            },
+            [values, &op](reference entry, size_type i) {
+                op(entry.second, values[i]);
+            }
+        );
+    }
+
+    // Group-by over a column of keys alone: each new key starts from a value-initialised accumulator, and every row
+    // calls op(accumulator). Suits counting.
+    template<typename Op> requires std::default_initializable<mapped_type> && std::invocable<Op&, mapped_type&>
+    auto aggregate(std::span<const key_type> keys, Op op) noexcept -> void {
+        m_hash_table.upsert_bulk(
+            keys,
+            [keys, &op](size_type i) {
+                auto entry = value_type{keys[i], mapped_type{}};
+                op(entry.second);
+                return entry;
+            },
+            [&op](reference entry, size_type) {
+                op(entry.second);
+            }
+        );
+    }
+
+    // Moves every entry of other into this map, calling op(value, std::move(other value)) for keys both maps hold.
+    // Meant for combining per-thread partial aggregates. other is empty afterwards.
+    template<typename Op> requires std::invocable<Op&, mapped_type&, mapped_type&&>
+    auto merge_with(unordered_map& other, Op op) noexcept -> void {
+        m_hash_table.merge_with(other.m_hash_table, [&op](reference entry, value_type&& incoming) {
+            op(entry.second, std::move(incoming.second));
+        });
+    }
+
+    template<typename Op> requires std::invocable<Op&, mapped_type&, mapped_type&&>
+    auto merge_with(unordered_map&& other, Op op) noexcept -> void {
+        merge_with(other, std::move(op));
+    }
+
+    auto extract(const key_type& key) noexcept -> node_type {
+        return m_hash_table.extract(key);
+    }
+
+    template<typename K> requires transparent_hash_eq
+    auto extract(const K& key) noexcept -> node_type {
+        return m_hash_table.extract(key);
+    }
+
     auto find(const key_type& key) noexcept -> iterator {
         return m_hash_table.find(key);
     }
@@ -216,6 +276,28 @@ public:
         return m_hash_table.contains(key);
     }
 
+    template<typename Predicate> requires std::predicate<Predicate&, const_reference>
+    auto erase_if(Predicate predicate, bool shrink = false) noexcept -> size_type {
+        return m_hash_table.erase_if(std::move(predicate), shrink);
+    }
+
+    template<typename Predicate> requires std::predicate<Predicate&, const_reference>
+    auto retain(Predicate predicate, bool shrink = false) noexcept -> size_type {
+        return m_hash_table.retain(std::move(predicate), shrink);
+    }
+
+    auto reserve(size_type count) noexcept -> void {
+        m_hash_table.reserve(count);
+    }
+
+    auto shrink_to_fit() noexcept -> void {
+        m_hash_table.shrink_to_fit();
+    }
+
+    auto clear() noexcept -> void {
+        m_hash_table.clear();
+    }
+
     [[nodiscard]] auto empty() const noexcept -> bool {
         return m_hash_table.empty();
     }
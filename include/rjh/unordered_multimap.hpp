@@ -0,0 +1,252 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RJH_UNORDERED_MULTIMAP_HPP
+#define RJH_UNORDERED_MULTIMAP_HPP
+
+#include "detail/hash_table.hpp"
+#include "detail/pair_hash.hpp"
+#include "hash.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace rjh {
+template<
+    typename Key,
+    typename Value,
+    concepts::hash_function_object<Key> Hash = rjh::hash<Key>,
+    concepts::key_equal_function_object<Key> KeyEqual = std::equal_to<Key>
+>
+class unordered_multimap {
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<key_type, mapped_type>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    static constexpr bool transparent_hash_eq = concepts::is_transparent<hasher> && concepts::is_transparent<key_equal>;
+
+private:
+    using pair_hash = detail::pair_hash<key_type, mapped_type, hasher>;
+    using pair_key_equal = detail::pair_key_equal<key_type, mapped_type, key_equal>;
+
+    using hash_table = detail::hash_table<value_type, pair_hash, pair_key_equal, true>;
+
+public:
+    template<typename T, typename It>
+    class raw_iterator final {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+        using mapped_reference = std::conditional_t<std::is_const_v<T>, const Value&, Value&>;
+        using table_iterator = It;
+
+        raw_iterator(table_iterator it) : m_iterator{it} {
+
+        }
+
+        auto operator*() const noexcept -> reference {
+            return m_iterator->key;
+        }
+
+        auto operator->() const noexcept -> pointer {
+            return &m_iterator->key;
+        }
+
+        auto key() const noexcept -> const Key& {
+            return m_iterator->key.first;
+        }
+
+        auto value() const noexcept -> mapped_reference {
+            return m_iterator->key.second;
+        }
+
+        auto operator++() noexcept -> raw_iterator& {
+            m_iterator++;
+            return *this;
+        }
+
+        auto operator++(int) noexcept -> raw_iterator {
+            auto temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        friend auto operator==(const raw_iterator& a, const raw_iterator& b) noexcept -> bool {
+            return a.m_iterator == b.m_iterator;
+        }
+
+        friend auto operator!=(const raw_iterator& a, const raw_iterator& b) noexcept -> bool {
+            return a.m_iterator != b.m_iterator;
+        }
+
+    private:
+        table_iterator m_iterator;
+    };
+
+    using iterator = raw_iterator<value_type, typename hash_table::iterator>;
+    using const_iterator = raw_iterator<const value_type, typename hash_table::const_iterator>;
+    using local_iterator = raw_iterator<value_type, typename hash_table::local_iterator>;
+    using const_local_iterator = raw_iterator<const value_type, typename hash_table::const_local_iterator>;
+
+    auto insert(const_reference pair) noexcept -> iterator {
+        return m_hash_table.insert(pair).first;
+    }
+
+    auto insert(value_type&& pair) noexcept -> iterator {
+        return m_hash_table.insert(std::move(pair)).first;
+    }
+
+    template<typename Pair> requires std::constructible_from<value_type, Pair&&>
+    auto insert(Pair&& pair) noexcept -> iterator {
+        return m_hash_table.insert(std::forward<Pair>(pair)).first;
+    }
+
+    auto find(const key_type& key) noexcept -> iterator {
+        return m_hash_table.find(key);
+    }
+
+    auto find(const key_type& key) const noexcept -> const_iterator {
+        return m_hash_table.find(key);
+    }
+
+    template<typename K> requires transparent_hash_eq
+    auto find(const K& key) noexcept -> iterator {
+        return m_hash_table.find(key);
+    }
+
+    template<typename K> requires transparent_hash_eq
+    auto find(const K& key) const noexcept -> const_iterator {
+        return m_hash_table.find(key);
+    }
+
+    auto contains(const key_type& key) const noexcept -> bool {
+        return m_hash_table.contains(key);
+    }
+
+    template<typename K> requires transparent_hash_eq
+    auto contains(const K& key) const noexcept -> bool {
+        return m_hash_table.contains(key);
+    }
+
+    auto count(const key_type& key) const noexcept -> size_type {
+        return m_hash_table.count(key);
+    }
+
+    template<typename K> requires transparent_hash_eq
+    auto count(const K& key) const noexcept -> size_type {
+        return m_hash_table.count(key);
+    }
+
+    auto equal_range(const key_type& key) noexcept -> std::pair<local_iterator, local_iterator> {
+        return m_hash_table.equal_range(key);
+    }
+
+    auto equal_range(const key_type& key) const noexcept -> std::pair<const_local_iterator, const_local_iterator> {
+        return m_hash_table.equal_range(key);
+    }
+
+    template<typename K> requires transparent_hash_eq
+    auto equal_range(const K& key) noexcept -> std::pair<local_iterator, local_iterator> {
+        return m_hash_table.equal_range(key);
+    }
+
+    template<typename K> requires transparent_hash_eq
+    auto equal_range(const K& key) const noexcept -> std::pair<const_local_iterator, const_local_iterator> {
+        return m_hash_table.equal_range(key);
+    }
+
+    auto erase(const key_type& key) noexcept -> size_type {
+        return m_hash_table.remove_all(key);
+    }
+
+    template<typename K> requires transparent_hash_eq
+    auto erase(const K& key) noexcept -> size_type {
+        return m_hash_table.remove_all(key);
+    }
+
+    template<typename Predicate> requires std::predicate<Predicate&, const_reference>
+    auto erase_if(Predicate predicate, bool shrink = false) noexcept -> size_type {
+        return m_hash_table.erase_if(std::move(predicate), shrink);
+    }
+
+    template<typename Predicate> requires std::predicate<Predicate&, const_reference>
+    auto retain(Predicate predicate, bool shrink = false) noexcept -> size_type {
+        return m_hash_table.retain(std::move(predicate), shrink);
+    }
+
+    auto shrink_to_fit() noexcept -> void {
+        m_hash_table.shrink_to_fit();
+    }
+
+    auto clear() noexcept -> void {
+        m_hash_table.clear();
+    }
+
+    [[nodiscard]] auto empty() const noexcept -> bool {
+        return m_hash_table.empty();
+    }
+
+    [[nodiscard]] auto capacity() const noexcept -> size_type {
+        return m_hash_table.capacity();
+    }
+
+    [[nodiscard]] auto size() const noexcept -> size_type {
+        return m_hash_table.size();
+    }
+
+    [[nodiscard]] auto begin() noexcept -> iterator {
+        return m_hash_table.begin();
+    }
+
+    [[nodiscard]] auto begin() const noexcept -> const_iterator {
+        return m_hash_table.begin();
+    }
+
+    [[nodiscard]] auto cbegin() const noexcept -> const_iterator {
+        return m_hash_table.cbegin();
+    }
+
+    [[nodiscard]] auto end() noexcept -> iterator {
+        return m_hash_table.end();
+    }
+
+    [[nodiscard]] auto end() const noexcept -> const_iterator {
+        return m_hash_table.end();
+    }
+
+    [[nodiscard]] auto cend() const noexcept -> const_iterator {
+        return m_hash_table.cend();
+    }
+
+private:
+    hash_table m_hash_table;
+}; // class unordered_multimap
+} // namespace rjh
+
+#endif // #ifndef RJH_UNORDERED_MULTIMAP_HPP
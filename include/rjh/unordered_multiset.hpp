@@ -0,0 +1,194 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RJH_UNORDERED_MULTISET_HPP
+#define RJH_UNORDERED_MULTISET_HPP
+
+#include "detail/hash_table.hpp"
+#include "hash.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+namespace rjh {
+template<typename Key, typename Hash = rjh::hash<Key>>
+class unordered_multiset {
+public:
+    using value_type = Key;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using hash_type = std::size_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+private:
+    using hash_table = detail::hash_table<value_type, hasher, std::equal_to<value_type>, true>;
+
+public:
+    template<typename T, typename It>
+    class raw_iterator final {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+        using table_iterator = It;
+
+        raw_iterator(table_iterator it) : m_iterator{it} {
+
+        }
+
+        auto operator*() const noexcept -> reference {
+            return m_iterator->key;
+        }
+
+        auto operator->() const noexcept -> pointer {
+            return &m_iterator->key;
+        }
+
+        auto operator++() noexcept -> raw_iterator& {
+            m_iterator++;
+            return *this;
+        }
+
+        auto operator++(int) noexcept -> raw_iterator {
+            auto temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        friend auto operator==(const raw_iterator& a, const raw_iterator& b) noexcept -> bool {
+            return a.m_iterator == b.m_iterator;
+        }
+
+        friend auto operator!=(const raw_iterator& a, const raw_iterator& b) noexcept -> bool {
+            return a.m_iterator != b.m_iterator;
+        }
+
+    private:
+        table_iterator m_iterator;
+    };
+
+    using iterator = raw_iterator<value_type, typename hash_table::iterator>;
+    using const_iterator = raw_iterator<value_type, typename hash_table::const_iterator>;
+    using local_iterator = raw_iterator<value_type, typename hash_table::local_iterator>;
+    using const_local_iterator = raw_iterator<value_type, typename hash_table::const_local_iterator>;
+
+    auto insert(const_reference key) noexcept -> iterator {
+        return m_hash_table.insert(key).first;
+    }
+
+    auto insert(value_type&& key) noexcept -> iterator {
+        return m_hash_table.insert(std::move(key)).first;
+    }
+
+    template<typename K> requires std::constructible_from<value_type, K&&>
+    auto insert(K&& key) noexcept -> iterator {
+        return m_hash_table.insert(std::forward<K>(key)).first;
+    }
+
+    auto find(const_reference key) noexcept -> iterator {
+        return m_hash_table.find(key);
+    }
+
+    auto find(const_reference key) const noexcept -> const_iterator {
+        return m_hash_table.find(key);
+    }
+
+    auto contains(const_reference key) const noexcept -> bool {
+        return m_hash_table.contains(key);
+    }
+
+    auto count(const_reference key) const noexcept -> size_type {
+        return m_hash_table.count(key);
+    }
+
+    auto equal_range(const_reference key) noexcept -> std::pair<local_iterator, local_iterator> {
+        return m_hash_table.equal_range(key);
+    }
+
+    auto equal_range(const_reference key) const noexcept -> std::pair<const_local_iterator, const_local_iterator> {
+        return m_hash_table.equal_range(key);
+    }
+
+    auto erase(const_reference key) noexcept -> size_type {
+        return m_hash_table.remove_all(key);
+    }
+
+    template<typename Predicate> requires std::predicate<Predicate&, const_reference>
+    auto erase_if(Predicate predicate, bool shrink = false) noexcept -> size_type {
+        return m_hash_table.erase_if(std::move(predicate), shrink);
+    }
+
+    template<typename Predicate> requires std::predicate<Predicate&, const_reference>
+    auto retain(Predicate predicate, bool shrink = false) noexcept -> size_type {
+        return m_hash_table.retain(std::move(predicate), shrink);
+    }
+
+    auto shrink_to_fit() noexcept -> void {
+        m_hash_table.shrink_to_fit();
+    }
+
+    auto clear() noexcept -> void {
+        m_hash_table.clear();
+    }
+
+    auto empty() const noexcept -> bool {
+        return m_hash_table.empty();
+    }
+
+    auto capacity() const noexcept -> size_type {
+        return m_hash_table.capacity();
+    }
+
+    auto size() const noexcept -> size_type {
+        return m_hash_table.size();
+    }
+
+    auto begin() noexcept -> iterator {
+        return m_hash_table.begin();
+    }
+
+    auto begin() const noexcept -> const_iterator {
+        return m_hash_table.begin();
+    }
+
+    auto cbegin() const noexcept -> const_iterator {
+        return m_hash_table.cbegin();
+    }
+
+    auto end() noexcept -> iterator {
+        return m_hash_table.end();
+    }
+
+    auto end() const noexcept -> const_iterator {
+        return m_hash_table.end();
+    }
+
+    auto cend() const noexcept -> const_iterator {
+        return m_hash_table.cend();
+    }
+
+private:
+    hash_table m_hash_table;
+};
+} // namespace rjh
+
+#endif // #ifndef RJH_UNORDERED_MULTISET_HPP
@@ -16,15 +16,21 @@
 #ifndef RJH_UNORDERED_SET_HPP
 #define RJH_UNORDERED_SET_HPP
 
-#include "detail/hash_table.hpp"
+#include "hash.hpp"
+#include "probing.hpp"
 
+#include <concepts>
 #include <cstddef>
 #include <functional>
 #include <iterator>
+#include <span>
 #include <utility>
 
 namespace rjh {
-template<typename Key, typename Hash = std::hash<Key>>
+// With Generational set, clear() leaves cleared keys to be overwritten on reuse, see detail::hash_table for how.
+// Meant for scratch sets that are refilled and cleared repeatedly. Probing picks the table engine, such as
+// swiss_probing in place of the default Robin Hood table.
+template<typename Key, typename Hash = rjh::hash<Key>, bool Generational = false, typename Probing = robin_hood_probing>
 class unordered_set {
 public:
     using value_type = Key;
@@ -35,6 +41,11 @@ public:
     using reference = value_type&;
     using const_reference = const value_type&;
 
+private:
+    using hash_table = typename Probing::template table<value_type, hasher, std::equal_to<value_type>, false, Generational>;
+
+public:
+
     template<typename T, typename It>
     class raw_iterator final {
     public:
@@ -80,8 +91,99 @@ public:
         table_iterator m_iterator;
     };
 
-    using iterator = raw_iterator<value_type, typename detail::hash_table<value_type, hasher>::iterator>;
-    using const_iterator = raw_iterator<value_type, typename detail::hash_table<value_type, hasher>::const_iterator>;
+    using iterator = raw_iterator<value_type, typename hash_table::iterator>;
+    using const_iterator = raw_iterator<value_type, typename hash_table::const_iterator>;
+    using node_type = typename hash_table::node_handle;
+
+    auto insert(const_reference key) noexcept -> std::pair<iterator, bool> {
+        return m_hash_table.insert(key);
+    }
+
+    auto insert(value_type&& key) noexcept -> std::pair<iterator, bool> {
+        return m_hash_table.insert(std::move(key));
+    }
+
+    template<typename K> requires std::constructible_from<value_type, K&&>
+    auto insert(K&& key) noexcept -> std::pair<iterator, bool> {
+        return m_hash_table.insert(std::forward<K>(key));
+    }
+
+    auto insert(node_type&& node) noexcept -> std::pair<iterator, bool> {
+        return m_hash_table.insert(std::move(node));
+    }
+
+    // Inserts every key and returns how many were not already present. Hashing is batched, so a hasher with a
+    // hash_batch member, such as rjh::hash for integers, hashes several keys per instruction.
+    auto insert_bulk(std::span<const value_type> keys) noexcept -> size_type {
+        return m_hash_table.insert_bulk(keys);
+    }
+
+    auto extract(const_reference key) noexcept -> node_type {
+        return m_hash_table.extract(key);
+    }
+
+    auto find(const_reference key) noexcept -> iterator {
+        return m_hash_table.find(key);
+    }
+
+    auto find(const_reference key) const noexcept -> const_iterator {
+        return m_hash_table.find(key);
+    }
+
+    auto contains(const_reference key) const noexcept -> bool {
+        return m_hash_table.contains(key);
+    }
+
+    // Sets found[i] to contains(keys[i]) and returns how many keys were found. found must be at least as long as keys.
+    auto contains_bulk(std::span<const value_type> keys, std::span<bool> found) const noexcept -> size_type {
+        return m_hash_table.contains_bulk(keys, found);
+    }
+
+    auto erase(const_reference key) noexcept -> bool {
+        return m_hash_table.remove(key);
+    }
+
+    auto merge(unordered_set& other) noexcept -> void {
+        m_hash_table.merge(other.m_hash_table);
+    }
+
+    auto merge(unordered_set&& other) noexcept -> void {
+        m_hash_table.merge(other.m_hash_table);
+    }
+
+    auto union_with(const unordered_set& other) noexcept -> void {
+        m_hash_table.union_with(other.m_hash_table);
+    }
+
+    auto intersect_with(const unordered_set& other) noexcept -> void {
+        m_hash_table.intersect_with(other.m_hash_table);
+    }
+
+    auto difference_with(const unordered_set& other) noexcept -> void {
+        m_hash_table.difference_with(other.m_hash_table);
+    }
+
+    auto is_subset_of(const unordered_set& other) const noexcept -> bool {
+        return m_hash_table.is_subset_of(other.m_hash_table);
+    }
+
+    template<typename Predicate> requires std::predicate<Predicate&, const_reference>
+    auto erase_if(Predicate predicate, bool shrink = false) noexcept -> size_type {
+        return m_hash_table.erase_if(std::move(predicate), shrink);
+    }
+
+    template<typename Predicate> requires std::predicate<Predicate&, const_reference>
+    auto retain(Predicate predicate, bool shrink = false) noexcept -> size_type {
+        return m_hash_table.retain(std::move(predicate), shrink);
+    }
+
+    auto reserve(size_type count) noexcept -> void {
+        m_hash_table.reserve(count);
+    }
+
+    auto shrink_to_fit() noexcept -> void {
+        m_hash_table.shrink_to_fit();
+    }
 
     auto clear() noexcept -> void {
         m_hash_table.clear();
@@ -124,7 +226,7 @@ public:
     }
 
 private:
-    detail::hash_table<value_type, hasher> m_hash_table;
+    hash_table m_hash_table;
 };
 } // namespace rjh
 
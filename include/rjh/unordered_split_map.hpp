@@ -0,0 +1,246 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RJH_UNORDERED_SPLIT_MAP_HPP
+#define RJH_UNORDERED_SPLIT_MAP_HPP
+
+#include "detail/hash_table.hpp"
+#include "detail/pair_hash.hpp"
+#include "hash.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace rjh {
+// An unordered_map that keeps values out of the probed bucket array. Each bucket holds the key and the index of its
+// value in a separate slab, so probing strides over keys and metadata only and a value is touched once, on a hit.
+// Prefer it to unordered_map when mapped_type is large. Erased slots are reused by later inserts; the slab only
+// shrinks on clear. An erased slot is reset to a default-constructed value, so mapped_type must be default
+// constructible.
+template<
+    typename Key,
+    std::default_initializable Value,
+    concepts::hash_function_object<Key> Hash = rjh::hash<Key>,
+    concepts::key_equal_function_object<Key> KeyEqual = std::equal_to<Key>
+>
+class unordered_split_map {
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<key_type, mapped_type>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    static constexpr bool transparent_hash_eq = concepts::is_transparent<hasher> && concepts::is_transparent<key_equal>;
+
+private:
+    using slot_index = std::uint32_t;
+
+    using table_value = std::pair<key_type, slot_index>;
+    using pair_hash = detail::pair_hash<key_type, slot_index, hasher>;
+    using pair_key_equal = detail::pair_key_equal<key_type, slot_index, key_equal>;
+
+    using hash_table = detail::hash_table<table_value, pair_hash, pair_key_equal>;
+
+public:
+    template<typename T, typename It>
+    class raw_iterator final {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type  = difference_type;
+        using mapped_type = T;
+        using value_type = std::pair<const key_type&, mapped_type&>;
+        using reference = value_type;
+        using table_iterator = It;
+
+        raw_iterator(table_iterator it, mapped_type* values) : m_iterator{it}, m_values{values} {
+
+        }
+
+        auto operator*() const noexcept -> reference {
+            return {key(), value()};
+        }
+
+        auto key() const noexcept -> const key_type& {
+            return m_iterator->key.first;
+        }
+
+        auto value() const noexcept -> mapped_type& {
+            return m_values[m_iterator->key.second];
+        }
+
+        auto operator++() noexcept -> raw_iterator& {
+            m_iterator++;
+            return *this;
+        }
+
+        auto operator++(int) noexcept -> raw_iterator {
+            auto temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        friend auto operator==(const raw_iterator& a, const raw_iterator& b) noexcept -> bool {
+            return a.m_iterator == b.m_iterator;
+        }
+
+        friend auto operator!=(const raw_iterator& a, const raw_iterator& b) noexcept -> bool {
+            return a.m_iterator != b.m_iterator;
+        }
+
+    private:
+        table_iterator m_iterator;
+        mapped_type* m_values;
+    };
+
+    using iterator = raw_iterator<mapped_type, typename hash_table::iterator>;
+    using const_iterator = raw_iterator<const mapped_type, typename hash_table::const_iterator>;
+
+    auto insert(const_reference pair) noexcept -> std::pair<iterator, bool> {
+        return insert(value_type{pair});
+    }
+
+    auto insert(value_type&& pair) noexcept -> std::pair<iterator, bool> {
+        auto [it, inserted] = m_hash_table.find_or_insert(pair.first, [this, &pair] {
+            return table_value{std::move(pair.first), acquire(std::move(pair.second))};
+        });
+        return {iterator{it, m_values.data()}, inserted};
+    }
+
+    template<typename Pair> requires std::constructible_from<value_type, Pair&&>
+    auto insert(Pair&& pair) noexcept -> std::pair<iterator, bool> {
+        return insert(value_type(std::forward<Pair>(pair)));
+    }
+
+    auto find(const key_type& key) noexcept -> iterator {
+        return {m_hash_table.find(key), m_values.data()};
+    }
+
+    auto find(const key_type& key) const noexcept -> const_iterator {
+        return {m_hash_table.find(key), m_values.data()};
+    }
+
+    template<typename K> requires transparent_hash_eq
+    auto find(const K& key) noexcept -> iterator {
+        return {m_hash_table.find(key), m_values.data()};
+    }
+
+    template<typename K> requires transparent_hash_eq
+    auto find(const K& key) const noexcept -> const_iterator {
+        return {m_hash_table.find(key), m_values.data()};
+    }
+
+    auto contains(const key_type& key) const noexcept -> bool {
+        return m_hash_table.contains(key);
+    }
+
+    template<typename K> requires transparent_hash_eq
+    auto contains(const K& key) const noexcept -> bool {
+        return m_hash_table.contains(key);
+    }
+
+    auto erase(const key_type& key) noexcept -> bool {
+        auto node = m_hash_table.extract(key);
+        if (node.empty()) {
+            return false;
+        }
+
+        release(node.key().second);
+        return true;
+    }
+
+    auto reserve(size_type count) noexcept -> void {
+        m_hash_table.reserve(count);
+        m_values.reserve(count);
+    }
+
+    auto clear() noexcept -> void {
+        m_hash_table.clear();
+        m_values.clear();
+        m_free.clear();
+    }
+
+    [[nodiscard]] auto empty() const noexcept -> bool {
+        return m_hash_table.empty();
+    }
+
+    [[nodiscard]] auto capacity() const noexcept -> size_type {
+        return m_hash_table.capacity();
+    }
+
+    [[nodiscard]] auto size() const noexcept -> size_type {
+        return m_hash_table.size();
+    }
+
+    [[nodiscard]] auto begin() noexcept -> iterator {
+        return {m_hash_table.begin(), m_values.data()};
+    }
+
+    [[nodiscard]] auto begin() const noexcept -> const_iterator {
+        return {m_hash_table.begin(), m_values.data()};
+    }
+
+    [[nodiscard]] auto cbegin() const noexcept -> const_iterator {
+        return begin();
+    }
+
+    [[nodiscard]] auto end() noexcept -> iterator {
+        return {m_hash_table.end(), m_values.data()};
+    }
+
+    [[nodiscard]] auto end() const noexcept -> const_iterator {
+        return {m_hash_table.end(), m_values.data()};
+    }
+
+    [[nodiscard]] auto cend() const noexcept -> const_iterator {
+        return end();
+    }
+
+private:
+    auto acquire(mapped_type&& value) noexcept -> slot_index {
+        if (m_free.empty()) {
+            m_values.push_back(std::move(value));
+            return static_cast<slot_index>(m_values.size() - 1);
+        }
+
+        const auto slot = m_free.back();
+        m_free.pop_back();
+        m_values[slot] = std::move(value);
+        return slot;
+    }
+
+    // Resets the value so that any resources it owns are released now rather than when the slot is reused.
+    auto release(slot_index slot) noexcept -> void {
+        m_values[slot] = mapped_type{};
+        m_free.push_back(slot);
+    }
+
+    hash_table m_hash_table;
+    std::vector<mapped_type> m_values;
+    std::vector<slot_index> m_free;
+}; // class unordered_split_map
+} // namespace rjh
+
+#endif // #ifndef RJH_UNORDERED_SPLIT_MAP_HPP
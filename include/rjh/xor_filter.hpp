@@ -0,0 +1,177 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RJH_XOR_FILTER_HPP
+#define RJH_XOR_FILTER_HPP
+
+#include "detail/hash_mix.hpp"
+#include "hash.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace rjh {
+// An immutable xor filter with 8-bit fingerprints, built once from a set of keys. It answers contains() with three
+// memory accesses, never gives a false negative for a key it was built from, and has a false positive rate of about
+// 1/256, using about 9.8 bits per key. Build it from any range of keys, such as an rjh::unordered_set.
+template<typename Key, typename Hash = rjh::hash<Key>>
+class xor_filter {
+public:
+    using key_type = Key;
+    using size_type = std::size_t;
+    using hash_type = std::size_t;
+    using hasher = Hash;
+    using fingerprint_type = std::uint8_t;
+
+    xor_filter() = default;
+
+    template<typename Range> requires requires(const Range& keys) { keys.begin(); keys.end(); }
+    explicit xor_filter(const Range& keys) {
+        std::vector<hash_type> hashes;
+        for (const auto& key : keys) {
+            hashes.push_back(hasher{}(key));
+        }
+
+        // Keys with equal hashes share all three slots and could never be peeled apart.
+        std::sort(hashes.begin(), hashes.end());
+        hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+        build(hashes);
+    }
+
+    [[nodiscard]] auto contains(const key_type& key) const noexcept -> bool {
+        if (m_fingerprints.empty()) {
+            return false;
+        }
+
+        const auto hash = seeded(hasher{}(key));
+        const auto [a, b, c] = slots(hash);
+        return fingerprint(hash) == (m_fingerprints[a] ^ m_fingerprints[b] ^ m_fingerprints[c]);
+    }
+
+    // The number of distinct key hashes the filter was built from.
+    [[nodiscard]] auto size() const noexcept -> size_type {
+        return m_size;
+    }
+
+    [[nodiscard]] auto size_in_bytes() const noexcept -> size_type {
+        return m_fingerprints.size() * sizeof(fingerprint_type);
+    }
+
+private:
+    auto build(const std::vector<hash_type>& hashes) noexcept -> void {
+        m_size = hashes.size();
+        if (m_size == 0) {
+            return;
+        }
+
+        m_block_length = (32 + m_size * 123 / 100 + 2) / 3;
+        const auto capacity = m_block_length * 3;
+
+        std::vector<std::uint32_t> counts(capacity);
+        std::vector<hash_type> masks(capacity);
+        std::vector<size_type> queue;
+        std::vector<std::pair<hash_type, size_type>> stack;
+        stack.reserve(m_size);
+
+        // Peeling fails with small probability for a given seed, in which case we try the next one.
+        for (m_seed = 1; ; m_seed++) {
+            std::fill(counts.begin(), counts.end(), std::uint32_t{0});
+            std::fill(masks.begin(), masks.end(), hash_type{0});
+            queue.clear();
+            stack.clear();
+
+            for (const auto key_hash : hashes) {
+                const auto hash = seeded(key_hash);
+                for (const auto slot : slots(hash)) {
+                    counts[slot]++;
+                    masks[slot] ^= hash;
+                }
+            }
+
+            for (size_type slot = 0; slot < capacity; slot++) {
+                if (counts[slot] == 1) {
+                    queue.push_back(slot);
+                }
+            }
+
+            while (!queue.empty()) {
+                const auto slot = queue.back();
+                queue.pop_back();
+                if (counts[slot] != 1) {
+                    continue;
+                }
+
+                const auto hash = masks[slot];
+                stack.emplace_back(hash, slot);
+                for (const auto other : slots(hash)) {
+                    masks[other] ^= hash;
+                    if (--counts[other] == 1) {
+                        queue.push_back(other);
+                    }
+                }
+            }
+
+            if (stack.size() == m_size) {
+                break;
+            }
+        }
+
+        // Assign in reverse peeling order, so each slot is the last of its key's three slots to be written.
+        m_fingerprints.assign(capacity, fingerprint_type{0});
+        for (auto it = stack.rbegin(); it != stack.rend(); ++it) {
+            const auto [hash, slot] = *it;
+            const auto [a, b, c] = slots(hash);
+            m_fingerprints[slot] = static_cast<fingerprint_type>(
+                fingerprint(hash) ^ m_fingerprints[a] ^ m_fingerprints[b] ^ m_fingerprints[c]
+            );
+        }
+    }
+
+    auto seeded(hash_type hash) const noexcept -> hash_type {
+        return detail::mix_hash(hash + m_seed);
+    }
+
+    // One slot in each third of the fingerprint array, taken from different bits of the hash.
+    auto slots(hash_type hash) const noexcept -> std::array<size_type, 3> {
+        return {
+            reduce(hash),
+            reduce(std::rotl(hash, 21)) + m_block_length,
+            reduce(std::rotl(hash, 42)) + 2 * m_block_length,
+        };
+    }
+
+    // Maps the low 32 bits of hash onto [0, m_block_length) without a division.
+    auto reduce(hash_type hash) const noexcept -> size_type {
+        return static_cast<size_type>((static_cast<std::uint64_t>(static_cast<std::uint32_t>(hash)) * m_block_length) >> 32);
+    }
+
+    static auto fingerprint(hash_type hash) noexcept -> fingerprint_type {
+        return static_cast<fingerprint_type>(hash ^ (hash >> 32));
+    }
+
+    std::vector<fingerprint_type> m_fingerprints;
+    size_type m_block_length{0};
+    size_type m_size{0};
+    hash_type m_seed{0};
+}; // class xor_filter
+} // namespace rjh
+
+#endif // #ifndef RJH_XOR_FILTER_HPP
@@ -13,5 +13,22 @@
  * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include "rjh/clock_cache.hpp"
+#include "rjh/filtered_unordered_set.hpp"
+#include "rjh/hash.hpp"
+#include "rjh/hash_analyzer.hpp"
+#include "rjh/lru_cache.hpp"
+#include "rjh/probing.hpp"
+#include "rjh/sentinel_unordered_map.hpp"
+#include "rjh/sentinel_unordered_set.hpp"
+#include "rjh/snapshot_unordered_map.hpp"
+#include "rjh/static_unordered_map.hpp"
+#include "rjh/static_unordered_set.hpp"
+#include "rjh/string_map.hpp"
+#include "rjh/string_set.hpp"
 #include "rjh/unordered_map.hpp"
+#include "rjh/unordered_multimap.hpp"
+#include "rjh/unordered_multiset.hpp"
 #include "rjh/unordered_set.hpp"
+#include "rjh/unordered_split_map.hpp"
+#include "rjh/xor_filter.hpp"
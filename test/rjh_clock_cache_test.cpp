@@ -0,0 +1,91 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "rjh/clock_cache.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+
+namespace rjh::tests {
+namespace {
+struct counting_hash {
+    static inline std::size_t calls = 0;
+
+    auto operator()(int key) const noexcept -> std::size_t {
+        calls++;
+        return rjh::hash<int>{}(key);
+    }
+};
+} // namespace
+
+TEST_CASE("rjh::clock_cache<int, std::string>", "[rjh::clock_cache tests]") {
+    clock_cache<int, std::string> cache{4};
+
+    for (auto i = 0; i < 4; i++) {
+        cache.put(i, std::to_string(i));
+    }
+    REQUIRE(cache.size() == 4);
+
+    REQUIRE(*cache.get(0) == "0");
+    REQUIRE(*cache.get(2) == "2");
+
+    cache.put(4, "4");
+    REQUIRE(cache.size() == 4);
+    REQUIRE(cache.contains(0));
+    REQUIRE(cache.contains(2));
+    REQUIRE(cache.contains(4));
+    REQUIRE(cache.contains(1) != cache.contains(3));
+
+    REQUIRE(cache.erase(4));
+    REQUIRE_FALSE(cache.erase(4));
+    REQUIRE(cache.size() == 3);
+    REQUIRE(*cache.peek(0) == "0");
+
+    cache.clear();
+    REQUIRE(cache.empty());
+}
+
+TEST_CASE("rjh::clock_cache does not grow past its capacity", "[rjh::clock_cache tests]") {
+    clock_cache<int, int> cache{100};
+    for (auto i = 0; i < 10000; i++) {
+        cache.put(i, i);
+        if (i % 3 == 0) {
+            cache.get(i);
+        }
+        REQUIRE(cache.size() == static_cast<std::size_t>(std::min(i + 1, 100)));
+    }
+    REQUIRE(cache.contains(9999));
+}
+
+TEST_CASE("rjh::clock_cache::put hashes the key once", "[rjh::clock_cache tests]") {
+    clock_cache<int, int, counting_hash> cache{2};
+    cache.put(1, 1);
+    cache.put(2, 2);
+
+    // A miss that evicts, then a hit that assigns.
+    counting_hash::calls = 0;
+    cache.put(3, 3);
+    REQUIRE(counting_hash::calls == 1);
+    REQUIRE(cache.size() == 2);
+
+    counting_hash::calls = 0;
+    cache.put(3, 30);
+    REQUIRE(counting_hash::calls == 1);
+    REQUIRE(*cache.get(3) == 30);
+}
+} // namespace rjh::tests
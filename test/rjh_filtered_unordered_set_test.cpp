@@ -0,0 +1,75 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "rjh/filtered_unordered_set.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <string>
+
+namespace rjh::tests {
+TEST_CASE("rjh::filtered_unordered_set<int>", "[rjh::filtered_unordered_set tests]") {
+    filtered_unordered_set<int> set;
+
+    for (auto i = 0; i < 10000; i++) {
+        REQUIRE(set.insert(i * 2).second);
+    }
+    REQUIRE_FALSE(set.insert(0).second);
+    REQUIRE(set.size() == 10000);
+
+    for (auto i = 0; i < 20000; i++) {
+        REQUIRE(set.contains(i) == (i % 2 == 0));
+        REQUIRE((set.find(i) != set.end()) == (i % 2 == 0));
+    }
+
+    for (auto i = 0; i < 20000; i += 4) {
+        REQUIRE(set.erase(i));
+    }
+    REQUIRE_FALSE(set.erase(0));
+    for (auto i = 0; i < 20000; i++) {
+        REQUIRE(set.contains(i) == (i % 4 == 2));
+    }
+
+    auto count = std::size_t{0};
+    for (const auto key : set) {
+        REQUIRE(key % 4 == 2);
+        count++;
+    }
+    REQUIRE(count == 5000);
+
+    set.clear();
+    REQUIRE(set.empty());
+    REQUIRE_FALSE(set.contains(2));
+}
+
+TEST_CASE("rjh::filtered_unordered_set<std::string>", "[rjh::filtered_unordered_set tests]") {
+    filtered_unordered_set<std::string> set;
+    set.reserve(1000);
+    for (auto i = 0; i < 1000; i++) {
+        set.insert(std::to_string(i));
+    }
+
+    auto misses = 0;
+    auto false_positives = 0;
+    for (auto i = 1000; i < 11000; i++) {
+        misses += !set.contains(std::to_string(i));
+        false_positives += set.may_contain(std::to_string(i));
+    }
+    REQUIRE(misses == 10000);
+    REQUIRE(false_positives < 200);
+    REQUIRE(set.contains("999"));
+}
+} // namespace rjh::tests
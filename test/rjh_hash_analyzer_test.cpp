@@ -0,0 +1,166 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "rjh/hash.hpp"
+#include "rjh/hash_analyzer.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace rjh::tests {
+namespace {
+struct identity_hash {
+    auto operator()(std::uint64_t key) const noexcept -> std::size_t {
+        return key;
+    }
+};
+
+struct constant_hash {
+    auto operator()(std::uint64_t) const noexcept -> std::size_t {
+        return 7;
+    }
+};
+
+struct order_id {
+    std::uint32_t venue;
+    std::uint32_t sequence;
+};
+
+// A composite hasher that forgets the venue.
+struct sequence_only_hash {
+    auto operator()(const order_id& id) const noexcept -> std::size_t {
+        return rjh::hash<std::uint32_t>{}(id.sequence);
+    }
+};
+
+auto strided_keys(std::size_t count, std::uint64_t stride) -> std::vector<std::uint64_t> {
+    std::vector<std::uint64_t> keys(count);
+    for (std::size_t i = 0; i < count; i++) {
+        keys[i] = i * stride;
+    }
+    return keys;
+}
+
+template<typename Report>
+auto find_reduction(const std::vector<Report>& reports, index_reduction reduction) -> const Report& {
+    for (const auto& report : reports) {
+        if (report.reduction == reduction) {
+            return report;
+        }
+    }
+    return reports.front();
+}
+} // namespace
+
+TEST_CASE("rjh::analyze_hash with a mixing hasher", "[rjh::hash_analyzer tests]") {
+    const auto keys = strided_keys(20000, 1024);
+    const auto report = analyze_hash(std::span<const std::uint64_t>{keys}, rjh::hash<std::uint64_t>{});
+
+    REQUIRE(report.keys == keys.size());
+    REQUIRE(report.distinct_hashes == keys.size());
+    REQUIRE(report.avalanche.has_value());
+    REQUIRE(report.avalanche->input_bits == 64);
+    REQUIRE(report.avalanche->mean_flipped_bits > 31);
+    REQUIRE(report.avalanche->mean_flipped_bits < 33);
+    REQUIRE(report.avalanche->worst_bias < 0.1);
+    REQUIRE(report.avalanche->dead_input_bits == 0);
+
+    REQUIRE(report.buckets.size() == all_index_reductions.size());
+    for (const auto& buckets : report.buckets) {
+        REQUIRE(buckets.collision_ratio < 1.1);
+    }
+
+    REQUIRE(report.probes.size() == 3 * all_index_reductions.size());
+    for (const auto& probes : report.probes) {
+        REQUIRE(probes.mean_distance < probes.ideal_mean_distance * 1.5 + 0.1);
+    }
+}
+
+TEST_CASE("rjh::analyze_hash with an identity hasher", "[rjh::hash_analyzer tests]") {
+    // Multiples of 1024 leave the low ten bits zero, so masking sends every key to one bucket in 1024, while the
+    // reductions that mix or keep the high bits still spread them out.
+    const auto keys = strided_keys(20000, 1024);
+    const auto report = analyze_hash(std::span<const std::uint64_t>{keys}, identity_hash{});
+
+    REQUIRE(report.distinct_hashes == keys.size());
+    REQUIRE(report.avalanche->mean_flipped_bits == 1);
+    REQUIRE(report.avalanche->worst_bias == 0.5);
+
+    REQUIRE(find_reduction(report.buckets, index_reduction::mask).collision_ratio > 100);
+    REQUIRE(find_reduction(report.buckets, index_reduction::mix_then_mask).collision_ratio < 1.1);
+    REQUIRE(find_reduction(report.buckets, index_reduction::modulo_prime).largest_bucket <= 2);
+
+    const auto& masked = find_reduction(report.probes, index_reduction::mask);
+    REQUIRE(masked.load_factor == 0.5);
+    REQUIRE(masked.mean_distance > 100 * masked.ideal_mean_distance);
+    const auto& mixed = find_reduction(report.probes, index_reduction::mix_then_mask);
+    REQUIRE(mixed.mean_distance < mixed.ideal_mean_distance * 1.5 + 0.1);
+}
+
+TEST_CASE("rjh::analyze_hash with a degenerate hasher", "[rjh::hash_analyzer tests]") {
+    const auto keys = strided_keys(1000, 1);
+    hash_analysis_options options;
+    options.load_factors = {0.9};
+    options.reductions = {index_reduction::mix_then_mask};
+    const auto report = analyze_hash(std::span<const std::uint64_t>{keys}, constant_hash{}, options);
+
+    REQUIRE(report.distinct_hashes == 1);
+    REQUIRE(report.avalanche->mean_flipped_bits == 0);
+    REQUIRE(report.avalanche->dead_input_bits == 64);
+    REQUIRE(report.buckets.size() == 1);
+    REQUIRE(report.buckets[0].largest_bucket == keys.size());
+
+    REQUIRE(report.probes.size() == 1);
+    const auto& probes = report.probes[0];
+    REQUIRE(probes.keys == probes.distance_counts.size());
+    REQUIRE(probes.max_distance == probes.keys - 1);
+    auto total = std::size_t{0};
+    for (const auto count : probes.distance_counts) {
+        REQUIRE(count == 1);
+        total += count;
+    }
+    REQUIRE(total == probes.keys);
+}
+
+TEST_CASE("rjh::analyze_hash with composite and string keys", "[rjh::hash_analyzer tests]") {
+    std::vector<order_id> ids;
+    for (std::uint32_t venue = 0; venue < 10; venue++) {
+        for (std::uint32_t sequence = 0; sequence < 100; sequence++) {
+            ids.push_back({venue, sequence});
+        }
+    }
+
+    // The ignored venue shows up as 32 dead input bits and as only 100 distinct hashes.
+    const auto composite = analyze_hash(std::span<const order_id>{ids}, sequence_only_hash{});
+    REQUIRE(composite.distinct_hashes == 100);
+    REQUIRE(composite.avalanche->input_bits == 64);
+    REQUIRE(composite.avalanche->dead_input_bits == 32);
+
+    std::vector<std::string> names;
+    for (auto i = 0; i < 5000; i++) {
+        names.push_back("customer-" + std::to_string(i));
+    }
+    const auto strings = analyze_hash(std::span<const std::string>{names}, std::hash<std::string>{});
+    REQUIRE(strings.distinct_hashes == names.size());
+    // Only the first 1000 keys are flipped, and the longest of those is "customer-999".
+    REQUIRE(strings.avalanche->input_bits == 12 * 8);
+    REQUIRE(strings.avalanche->dead_input_bits == 0);
+    REQUIRE(find_reduction(strings.buckets, index_reduction::mask).collision_ratio < 1.2);
+}
+} // namespace rjh::tests
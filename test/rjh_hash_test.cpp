@@ -0,0 +1,124 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "rjh/hash.hpp"
+#include "rjh/unordered_set.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace rjh::tests {
+namespace {
+template<typename Key>
+auto check_batch(const std::vector<Key>& keys) -> void {
+    const rjh::hash<Key> hasher;
+    std::vector<std::size_t> hashes(keys.size());
+    hasher.hash_batch(keys, hashes);
+    for (std::size_t i = 0; i < keys.size(); i++) {
+        REQUIRE(hashes[i] == hasher(keys[i]));
+    }
+}
+
+template<std::size_t Size>
+auto byte_keys(std::size_t count) -> std::vector<std::array<unsigned char, Size>> {
+    std::vector<std::array<unsigned char, Size>> keys(count);
+    for (std::size_t i = 0; i < count; i++) {
+        for (std::size_t j = 0; j < Size; j++) {
+            keys[i][j] = static_cast<unsigned char>(i * 31 + j * 7);
+        }
+    }
+    return keys;
+}
+} // namespace
+
+TEST_CASE("rjh::hash batches match single keys", "[rjh::hash tests]") {
+    // Odd lengths leave a scalar tail after the SIMD lanes.
+    std::vector<std::uint64_t> u64;
+    std::vector<std::int64_t> i64;
+    std::vector<std::uint32_t> u32;
+    std::vector<int> i32;
+    std::vector<std::uint16_t> u16;
+    for (std::uint64_t i = 0; i < 1003; i++) {
+        u64.push_back(i * 0x9e3779b97f4a7c15ull);
+        i64.push_back(static_cast<std::int64_t>(i) - 500);
+        u32.push_back(static_cast<std::uint32_t>(i * 2654435761u));
+        i32.push_back(static_cast<int>(i) - 500);
+        u16.push_back(static_cast<std::uint16_t>(i));
+    }
+
+    check_batch(u64);
+    check_batch(i64);
+    check_batch(u32);
+    check_batch(i32);
+    check_batch(u16);
+    check_batch(byte_keys<3>(101));
+    check_batch(byte_keys<8>(101));
+    check_batch(byte_keys<16>(101));
+    check_batch(byte_keys<20>(101));
+}
+
+TEST_CASE("rjh::hash mixes integer keys", "[rjh::hash tests]") {
+    const rjh::hash<std::uint64_t> hasher;
+    REQUIRE(hasher(1) != 1);
+    REQUIRE(hasher(1) != hasher(2));
+    // Keys a power of two apart must not share their low bits, which is all a small table looks at.
+    REQUIRE((hasher(1024) & 0xff) != (hasher(2048) & 0xff));
+
+    // Signed keys hash by their unsigned bit pattern.
+    REQUIRE(rjh::hash<int>{}(-1) == rjh::hash<unsigned>{}(0xffffffffu));
+
+    // Byte arrays that differ only past the first word hash differently.
+    std::array<std::byte, 12> a{};
+    auto b = a;
+    b[11] = std::byte{1};
+    REQUIRE(rjh::hash<std::array<std::byte, 12>>{}(a) != rjh::hash<std::array<std::byte, 12>>{}(b));
+}
+
+TEST_CASE("rjh::unordered_set bulk insert and lookup", "[rjh::hash tests]") {
+    std::vector<std::uint64_t> keys;
+    for (std::uint64_t i = 0; i < 10000; i++) {
+        keys.push_back(i % 5000 * 3);
+    }
+
+    unordered_set<std::uint64_t> set;
+    REQUIRE(set.insert_bulk(keys) == 5000);
+    REQUIRE(set.size() == 5000);
+    REQUIRE(set.insert_bulk(keys) == 0);
+
+    std::vector<std::uint64_t> probes;
+    for (std::uint64_t i = 0; i < 15000; i++) {
+        probes.push_back(i);
+    }
+
+    const auto found = std::make_unique<bool[]>(probes.size());
+    REQUIRE(set.contains_bulk(probes, {found.get(), probes.size()}) == 5000);
+    for (std::uint64_t i = 0; i < 15000; i++) {
+        REQUIRE(found[i] == (i % 3 == 0));
+        REQUIRE(found[i] == set.contains(i));
+    }
+
+    // Keys without a batch hasher are hashed one at a time.
+    unordered_set<std::string> strings;
+    const std::vector<std::string> words{"alpha", "beta", "alpha", "gamma"};
+    REQUIRE(strings.insert_bulk(words) == 3);
+    REQUIRE(strings.contains("gamma"));
+}
+} // namespace rjh::tests
@@ -0,0 +1,212 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "rjh/probing.hpp"
+#include "rjh/unordered_map.hpp"
+#include "rjh/unordered_set.hpp"
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <span>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace rjh::tests {
+namespace {
+struct constant_hash {
+    auto operator()(int) const noexcept -> std::size_t {
+        return 7;
+    }
+};
+} // namespace
+
+// Every engine runs the same cases and must give the same answers.
+
+TEMPLATE_TEST_CASE("rjh::unordered_set random operations", "[rjh::probing tests]", robin_hood_probing, swiss_probing) {
+    unordered_set<std::uint32_t, rjh::hash<std::uint32_t>, false, TestType> set;
+    std::unordered_set<std::uint32_t> expected;
+    std::mt19937 engine{7};
+    std::uniform_int_distribution<std::uint32_t> keys{0, 4000};
+
+    // Inserts outnumber erases early on and erases catch up later, so the table grows, churns and then drains.
+    for (auto step = 0; step < 200000; step++) {
+        const auto key = keys(engine);
+        if (engine() % 1000 < static_cast<std::uint32_t>(600 - step / 500)) {
+            REQUIRE(set.insert(key).second == expected.insert(key).second);
+        } else {
+            REQUIRE(set.erase(key) == (expected.erase(key) == 1));
+        }
+        REQUIRE(set.contains(key) == expected.contains(key));
+    }
+
+    REQUIRE(set.size() == expected.size());
+    auto count = std::size_t{0};
+    for (const auto key : set) {
+        REQUIRE(expected.contains(key));
+        count++;
+    }
+    REQUIRE(count == expected.size());
+}
+
+TEMPLATE_TEST_CASE("rjh::unordered_set colliding erase churn", "[rjh::probing tests]", robin_hood_probing, swiss_probing) {
+    // Every key shares a hash, so each lookup walks past every earlier key and every erase leaves a gap in the run.
+    unordered_set<int, constant_hash, false, TestType> set;
+    for (auto round = 0; round < 20; round++) {
+        for (auto i = 0; i < 100; i++) {
+            REQUIRE(set.insert(round * 100 + i).second);
+        }
+        for (auto i = 0; i < 100; i += 2) {
+            REQUIRE(set.erase(round * 100 + i));
+        }
+        for (auto i = 0; i < 100; i++) {
+            REQUIRE(set.contains(round * 100 + i) == (i % 2 == 1));
+        }
+    }
+    REQUIRE(set.size() == 1000);
+}
+
+TEMPLATE_TEST_CASE("rjh::unordered_set capacity", "[rjh::probing tests]", robin_hood_probing, swiss_probing) {
+    unordered_set<int, rjh::hash<int>, false, TestType> set;
+    set.reserve(1000);
+    const auto reserved = set.capacity();
+    REQUIRE(reserved >= 1000);
+
+    for (auto i = 0; i < 1000; i++) {
+        set.insert(i);
+    }
+    REQUIRE(set.capacity() == reserved);
+
+    set.retain([](int key) { return key < 10; }, true);
+    REQUIRE(set.capacity() < reserved);
+    REQUIRE(set.size() == 10);
+    for (auto i = 0; i < 1000; i++) {
+        REQUIRE(set.contains(i) == (i < 10));
+    }
+
+    set.clear();
+    REQUIRE(set.empty());
+    REQUIRE(set.begin() == set.end());
+}
+
+TEMPLATE_TEST_CASE("rjh::unordered_set engine set operations", "[rjh::probing tests]", robin_hood_probing, swiss_probing) {
+    using set_type = unordered_set<int, rjh::hash<int>, false, TestType>;
+    const auto make_range = [](int first, int last) {
+        set_type set;
+        for (auto i = first; i < last; i++) {
+            set.insert(i);
+        }
+        return set;
+    };
+
+    auto a = make_range(0, 100);
+    a.union_with(make_range(50, 300));
+    REQUIRE(a.size() == 300);
+
+    a.intersect_with(make_range(100, 1000));
+    REQUIRE(a.size() == 200);
+
+    a.difference_with(make_range(0, 150));
+    REQUIRE(a.size() == 150);
+    REQUIRE(a.is_subset_of(make_range(150, 300)));
+    REQUIRE_FALSE(a.is_subset_of(make_range(151, 300)));
+
+    // The same operations with the larger table on the other side.
+    auto c = make_range(0, 1000);
+    c.union_with(make_range(990, 1010));
+    REQUIRE(c.size() == 1010);
+
+    c.intersect_with(make_range(500, 520));
+    REQUIRE(c.size() == 20);
+
+    auto d = make_range(0, 10);
+    d.difference_with(make_range(5, 1000));
+    REQUIRE(d.size() == 5);
+    for (auto i = 0; i < 1010; i++) {
+        REQUIRE(c.contains(i) == (i >= 500 && i < 520));
+        REQUIRE(d.contains(i) == (i < 5));
+    }
+
+    auto b = make_range(250, 400);
+    a.merge(b);
+    REQUIRE(a.size() == 250);
+    REQUIRE(b.size() == 50);
+    for (auto i = 250; i < 300; i++) {
+        REQUIRE(b.contains(i));
+    }
+
+    const std::vector<int> keys{1, 2, 3, 150, 151};
+    bool found[5];
+    REQUIRE(a.contains_bulk(keys, found) == 2);
+    REQUIRE(a.insert_bulk(keys) == 3);
+    REQUIRE(a.size() == 253);
+}
+
+TEMPLATE_TEST_CASE("rjh::unordered_set generational clear", "[rjh::probing tests]", robin_hood_probing, swiss_probing) {
+    unordered_set<std::string, rjh::hash<std::string>, true, TestType> set;
+    for (auto round = 0; round < 300; round++) {
+        for (auto i = 0; i < 50; i++) {
+            REQUIRE(set.insert(std::to_string(round * 7 + i)).second);
+        }
+        REQUIRE(set.size() == 50);
+        REQUIRE(set.contains(std::to_string(round * 7)));
+        set.clear();
+        REQUIRE(set.empty());
+        REQUIRE_FALSE(set.contains(std::to_string(round * 7)));
+        REQUIRE(set.begin() == set.end());
+    }
+}
+
+TEMPLATE_TEST_CASE("rjh::unordered_map engine interface", "[rjh::probing tests]", robin_hood_probing, swiss_probing) {
+    using map_type = unordered_map<std::string, int, rjh::hash<std::string>, std::equal_to<std::string>, false, TestType>;
+    map_type map;
+    for (auto i = 0; i < 100; i++) {
+        REQUIRE(map.insert({std::to_string(i), i}).second);
+    }
+
+    REQUIRE(map.find("42")->second == 42);
+    REQUIRE(map.upsert_with("42", 1, [](int& value, int more) { value += more; }).first->second == 43);
+    REQUIRE(map.upsert_with("new", 5, [](int& value, int more) { value += more; }).second);
+
+    auto node = map.extract("7");
+    REQUIRE(node.key() == "7");
+    REQUIRE_FALSE(map.contains("7"));
+    map_type other;
+    REQUIRE(other.insert(std::move(node)).second);
+    REQUIRE(other.find("7")->second == 7);
+
+    other.insert({"8", 100});
+    map.merge_with(other, [](int& value, int&& incoming) { value += incoming; });
+    REQUIRE(other.empty());
+    REQUIRE(map.find("7")->second == 7);
+    REQUIRE(map.find("8")->second == 108);
+
+    const std::vector<std::string> keys{"a", "b", "a", "42"};
+    map.aggregate(std::span<const std::string>{keys}, [](int& count) { count++; });
+    REQUIRE(map.find("a")->second == 2);
+    REQUIRE(map.find("b")->second == 1);
+    REQUIRE(map.find("42")->second == 44);
+
+    REQUIRE(map.erase_if([](const auto& entry) { return entry.second % 2 == 0; }) > 0);
+    for (const auto& [key, value] : map) {
+        REQUIRE(value % 2 == 1);
+    }
+}
+} // namespace rjh::tests
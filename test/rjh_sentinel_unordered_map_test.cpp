@@ -0,0 +1,52 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "rjh/sentinel_unordered_map.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <string>
+
+namespace rjh::tests {
+TEST_CASE("rjh::sentinel_unordered_map<std::uint32_t, std::string>", "[rjh::sentinel_unordered_map tests]") {
+    sentinel_unordered_map<std::uint32_t, std::string> map;
+
+    for (std::uint32_t i = 0; i < 1000; i++) {
+        REQUIRE(map.insert({i, std::to_string(i)}).second);
+    }
+    REQUIRE_FALSE(map.insert({7, "seven"}).second);
+    REQUIRE_FALSE(map.insert({map.empty_key, "empty"}).second);
+    REQUIRE(map.find(7).value() == "7");
+    REQUIRE(map.find(1000) == map.end());
+
+    map.find(8).value() = "eight";
+    REQUIRE(map.find(8)->second == "eight");
+
+    for (std::uint32_t i = 0; i < 1000; i += 2) {
+        REQUIRE(map.erase(i));
+    }
+    REQUIRE(map.size() == 500);
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        REQUIRE(it.key() % 2 == 1);
+        REQUIRE(it.value() == std::to_string(it.key()));
+    }
+
+    const auto& const_map = map;
+    REQUIRE(const_map.find(999).value() == "999");
+    REQUIRE(map.erase_if([](const auto& pair) { return pair.first > 100; }) == 450);
+    REQUIRE(map.size() == 50);
+}
+} // namespace rjh::tests
@@ -0,0 +1,152 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "rjh/sentinel_unordered_set.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <set>
+
+namespace rjh::tests {
+namespace {
+// Sends every key to the last bucket of the initial capacity, so the cluster wraps around to the start of the array.
+struct last_bucket_hash {
+    using is_avalanching = void;
+
+    auto operator()(std::uint32_t) const noexcept -> std::size_t {
+        return 7;
+    }
+};
+
+// Three home buckets for every key, so removals happen inside a cluster of entries with different homes.
+struct three_homes_hash {
+    using is_avalanching = void;
+
+    auto operator()(std::uint32_t key) const noexcept -> std::size_t {
+        return key % 3;
+    }
+};
+} // namespace
+
+TEST_CASE("rjh::sentinel_unordered_set<std::uint32_t>", "[rjh::sentinel_unordered_set tests]") {
+    sentinel_unordered_set<std::uint32_t> set;
+
+    for (std::uint32_t i = 0; i < 1000; i++) {
+        REQUIRE(set.insert(i * 3).second);
+    }
+    REQUIRE_FALSE(set.insert(3).second);
+    REQUIRE(*set.insert(3).first == 3);
+    REQUIRE_FALSE(set.insert(set.empty_key).second);
+    REQUIRE_FALSE(set.contains(set.empty_key));
+    REQUIRE(set.size() == 1000);
+
+    for (std::uint32_t i = 0; i < 3000; i++) {
+        REQUIRE(set.contains(i) == (i % 3 == 0));
+    }
+
+    for (std::uint32_t i = 0; i < 3000; i += 6) {
+        REQUIRE(set.erase(i));
+    }
+    REQUIRE_FALSE(set.erase(0));
+    REQUIRE(set.size() == 500);
+
+    auto count = std::size_t{0};
+    for (const auto key : set) {
+        REQUIRE(key % 6 == 3);
+        count++;
+    }
+    REQUIRE(count == 500);
+
+    REQUIRE(set.erase_if([](std::uint32_t key) { return key < 1500; }) == 250);
+    REQUIRE(set.size() == 250);
+
+    set.clear();
+    REQUIRE(set.empty());
+    REQUIRE(set.begin() == set.end());
+}
+
+TEST_CASE("rjh::sentinel_unordered_set erase_if with a wrapped cluster", "[rjh::sentinel_unordered_set tests]") {
+    sentinel_unordered_set<std::uint32_t, std::numeric_limits<std::uint32_t>::max(), last_bucket_hash> set;
+    for (std::uint32_t i = 0; i < 5; i++) {
+        REQUIRE(set.insert(i).second);
+    }
+    REQUIRE(set.capacity() == 8);
+
+    // Removing the entry in the last bucket shifts the entries from the start of the array behind it.
+    auto calls = std::size_t{0};
+    REQUIRE(set.erase_if([&calls](std::uint32_t key) {
+        calls++;
+        return key % 2 == 0;
+    }) == 3);
+    REQUIRE(calls == 5);
+    REQUIRE(set.size() == 2);
+    REQUIRE(set.contains(1));
+    REQUIRE(set.contains(3));
+}
+
+TEST_CASE("rjh::sentinel_unordered_set removal inside a cluster", "[rjh::sentinel_unordered_set tests]") {
+    for (std::uint32_t removed = 0; removed < 12; removed++) {
+        sentinel_unordered_set<std::uint32_t, std::numeric_limits<std::uint32_t>::max(), three_homes_hash> set;
+        for (std::uint32_t i = 0; i < 12; i++) {
+            REQUIRE(set.insert(i).second);
+        }
+
+        REQUIRE(set.erase(removed));
+        for (std::uint32_t i = 0; i < 12; i++) {
+            REQUIRE(set.contains(i) == (i != removed));
+        }
+    }
+}
+
+TEST_CASE("rjh::sentinel_unordered_set with a custom sentinel", "[rjh::sentinel_unordered_set tests]") {
+    sentinel_unordered_set<int, 0> set;
+    REQUIRE_FALSE(set.insert(0).second);
+    REQUIRE(set.insert(-1).second);
+    REQUIRE(set.insert(std::numeric_limits<int>::max()).second);
+    REQUIRE(set.size() == 2);
+
+    int values[4]{};
+    sentinel_unordered_set<int*> pointers;
+    for (auto& value : values) {
+        REQUIRE(pointers.insert(&value).second);
+    }
+    REQUIRE_FALSE(pointers.insert(nullptr).second);
+    REQUIRE(pointers.contains(&values[2]));
+}
+
+TEST_CASE("rjh::sentinel_unordered_set random operations", "[rjh::sentinel_unordered_set tests]") {
+    sentinel_unordered_set<std::uint64_t> set;
+    std::set<std::uint64_t> reference;
+
+    auto state = std::uint64_t{12345};
+    for (auto i = 0; i < 20000; i++) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        const auto key = (state >> 33) % 4096;
+        if (state & 1) {
+            REQUIRE(set.insert(key).second == reference.insert(key).second);
+        } else {
+            REQUIRE(set.erase(key) == (reference.erase(key) == 1));
+        }
+    }
+
+    REQUIRE(set.size() == reference.size());
+    for (const auto key : reference) {
+        REQUIRE(set.contains(key));
+    }
+}
+} // namespace rjh::tests
@@ -0,0 +1,179 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "rjh/snapshot_unordered_map.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace rjh::tests {
+TEST_CASE("rjh::snapshot_unordered_map<int, std::string>", "[rjh::snapshot_unordered_map tests]") {
+    snapshot_unordered_map<int, std::string> map;
+    std::unordered_map<int, std::string> expected;
+    std::mt19937 engine{3};
+    std::uniform_int_distribution<int> keys{0, 3000};
+
+    for (auto step = 0; step < 100000; step++) {
+        const auto key = keys(engine);
+        switch (engine() % 4) {
+            case 0:
+                REQUIRE(map.insert({key, "i"}).second == expected.insert({key, "i"}).second);
+                break;
+            case 1:
+                REQUIRE(map.insert_or_assign(key, std::to_string(step)).second
+                    == expected.insert_or_assign(key, std::to_string(step)).second);
+                break;
+            case 2:
+                map.upsert_with(key, std::string{"+"}, [](std::string& value, std::string&& more) { value += more; });
+                expected[key] += "+";
+                break;
+            default:
+                REQUIRE(map.erase(key) == (expected.erase(key) == 1));
+                break;
+        }
+    }
+
+    REQUIRE(map.size() == expected.size());
+    auto count = std::size_t{0};
+    for (const auto& [key, value] : map) {
+        REQUIRE(expected.at(key) == value);
+        count++;
+    }
+    REQUIRE(count == expected.size());
+
+    REQUIRE(map.erase_if([](const auto& entry) { return entry.first % 3 == 0; }) > 0);
+    for (const auto& [key, value] : expected) {
+        REQUIRE(map.contains(key) == (key % 3 != 0));
+    }
+}
+
+TEST_CASE("rjh::snapshot_unordered_map snapshots", "[rjh::snapshot_unordered_map tests]") {
+    snapshot_unordered_map<int, int> map;
+    map.reserve(100000);
+    for (auto i = 0; i < 100000; i++) {
+        map.insert({i, i});
+    }
+    REQUIRE(map.shared_chunks() == 0);
+
+    const auto snapshot = map.snapshot();
+    const auto chunks = map.shared_chunks();
+    REQUIRE(chunks > 1);
+
+    // One write copies the one chunk it lands in.
+    REQUIRE_FALSE(map.insert_or_assign(500, -1).second);
+    REQUIRE(map.shared_chunks() == chunks - 1);
+    REQUIRE(map.find(500).value() == -1);
+    REQUIRE(snapshot.find(500).value() == 500);
+
+    REQUIRE(map.erase(7));
+    map.insert({-7, 7});
+    REQUIRE_FALSE(map.contains(7));
+    REQUIRE(snapshot.contains(7));
+    REQUIRE_FALSE(snapshot.contains(-7));
+    REQUIRE(snapshot.find(-7) == snapshot.end());
+
+    // Growing rebuilds every chunk, so nothing is left shared and the snapshot still holds the old contents.
+    for (auto i = 100000; i < 300000; i++) {
+        map.insert({i, i});
+    }
+    REQUIRE(map.shared_chunks() == 0);
+    REQUIRE(snapshot.size() == 100000);
+    auto sum = 0ll;
+    for (const auto& [key, value] : snapshot) {
+        REQUIRE(key == value);
+        sum += value;
+    }
+    REQUIRE(sum == 100000ll * 99999 / 2);
+
+    const auto second = map.snapshot();
+    map.clear();
+    REQUIRE(map.empty());
+    REQUIRE(map.begin() == map.end());
+    REQUIRE(second.size() == 300000);
+    REQUIRE(second.contains(299999));
+}
+
+TEST_CASE("rjh::snapshot_unordered_map copies", "[rjh::snapshot_unordered_map tests]") {
+    snapshot_unordered_map<std::string, int> a;
+    for (auto i = 0; i < 5000; i++) {
+        a.insert({std::to_string(i), i});
+    }
+
+    auto b = a;
+    REQUIRE(a.shared_chunks() == b.shared_chunks());
+    REQUIRE(a.shared_chunks() > 0);
+
+    a.insert_or_assign("1", 10);
+    b.insert_or_assign("1", 20);
+    b.erase("2");
+    REQUIRE(a.find("1").value() == 10);
+    REQUIRE(b.find("1").value() == 20);
+    REQUIRE(a.contains("2"));
+    REQUIRE_FALSE(b.contains("2"));
+}
+
+TEST_CASE("rjh::snapshot_unordered_map concurrent readers", "[rjh::snapshot_unordered_map tests]") {
+    // The writer keeps every value equal to the current round and publishes a snapshot after each round, so a reader
+    // that ever sees two different values in one snapshot has seen a torn copy.
+    static constexpr int key_count = 20000;
+    static constexpr int rounds = 50;
+
+    snapshot_unordered_map<int, int> map;
+    for (auto i = 0; i < key_count; i++) {
+        map.insert({i, 0});
+    }
+
+    std::vector<snapshot_unordered_map<int, int>::snapshot_type> published;
+    published.reserve(rounds + 1);
+    published.push_back(map.snapshot());
+    std::atomic<std::size_t> ready{1};
+    std::atomic<int> torn{0};
+
+    std::vector<std::thread> readers;
+    for (auto t = 0; t < 3; t++) {
+        readers.emplace_back([&published, &ready, &torn] {
+            for (std::size_t seen = 0; seen < rounds + 1; seen = ready.load(std::memory_order_acquire)) {
+                const auto snapshot = published[ready.load(std::memory_order_acquire) - 1];
+                const auto first = snapshot.find(0).value();
+                for (const auto& [key, value] : snapshot) {
+                    torn += value != first;
+                }
+                torn += snapshot.size() != key_count;
+            }
+        });
+    }
+
+    for (auto round = 1; round <= rounds; round++) {
+        for (auto i = 0; i < key_count; i++) {
+            map.insert_or_assign(i, round);
+        }
+        published.push_back(map.snapshot());
+        ready.store(published.size(), std::memory_order_release);
+    }
+
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    REQUIRE(torn == 0);
+    REQUIRE(published.back().find(key_count - 1).value() == rounds);
+}
+} // namespace rjh::tests
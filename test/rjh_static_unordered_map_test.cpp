@@ -0,0 +1,66 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "rjh/static_unordered_map.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+namespace rjh::tests {
+namespace {
+struct no_default {
+    explicit no_default(int) noexcept {}
+};
+
+template<typename Value>
+concept storable = requires {
+    typename static_unordered_map<int, Value, 4>;
+};
+
+// Buckets hold constructed values, so a mapped type without a default constructor is rejected up front.
+static_assert(storable<std::string>);
+static_assert(!storable<no_default>);
+} // namespace
+
+TEST_CASE("rjh::static_unordered_map<int, std::string, 64>", "[rjh::static_unordered_map tests]") {
+    static_unordered_map<int, std::string, 64> map;
+    static_assert(noexcept(map.insert({1, std::string{}})));
+
+    for (auto i = 0; i < 64; i++) {
+        REQUIRE(map.insert({i, std::to_string(i)}).second);
+    }
+    REQUIRE_FALSE(map.insert({64, "full"}).second);
+    REQUIRE(map.find(64) == map.end());
+    REQUIRE(map.find(7).value() == "7");
+
+    map.find(8).value() = "eight";
+    REQUIRE(map.find(8)->second == "eight");
+
+    for (auto i = 0; i < 64; i += 2) {
+        REQUIRE(map.erase(i));
+    }
+    REQUIRE(map.size() == 32);
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        REQUIRE(it.key() % 2 == 1);
+    }
+
+    REQUIRE(map.insert({64, "64"}).second);
+    const auto& const_map = map;
+    REQUIRE(const_map.find(64).value() == "64");
+    REQUIRE(map.erase_if([](const auto& pair) { return pair.first > 32; }) == 17);
+    REQUIRE(map.size() == 16);
+}
+} // namespace rjh::tests
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "rjh/static_unordered_set.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace rjh::tests {
+namespace {
+struct constant_hash {
+    auto operator()(int) const noexcept -> std::size_t {
+        return 7;
+    }
+};
+
+// Sends every key to the last bucket of a static_unordered_set<int, 8>, so the cluster wraps around to the start.
+struct last_bucket_hash {
+    using is_avalanching = void;
+
+    auto operator()(int) const noexcept -> std::size_t {
+        return 15;
+    }
+};
+} // namespace
+
+TEST_CASE("rjh::static_unordered_set<int, 100>", "[rjh::static_unordered_set tests]") {
+    static_unordered_set<int, 100> set;
+    static_assert(noexcept(set.insert(1)));
+    static_assert(set.capacity() == 100);
+    REQUIRE(set.bucket_count() >= 134);
+
+    for (auto i = 0; i < 100; i++) {
+        REQUIRE(set.insert(i).second);
+    }
+    REQUIRE_FALSE(set.insert(5).second);
+    REQUIRE(*set.insert(5).first == 5);
+
+    // Full: a new key is refused rather than triggering growth.
+    const auto [it, inserted] = set.insert(100);
+    REQUIRE_FALSE(inserted);
+    REQUIRE(it == set.end());
+    REQUIRE(set.size() == 100);
+    REQUIRE(set.longest_probe() <= set.probe_limit);
+
+    REQUIRE(set.erase(50));
+    REQUIRE_FALSE(set.contains(50));
+    REQUIRE(set.insert(100).second);
+    REQUIRE(set.contains(100));
+
+    auto count = 0;
+    for (const auto key : set) {
+        REQUIRE(key != 50);
+        count++;
+    }
+    REQUIRE(count == 100);
+
+    REQUIRE(set.erase_if([](int key) { return key % 2 == 0; }) == 50);
+    for (auto i = 0; i <= 100; i++) {
+        REQUIRE(set.contains(i) == (i % 2 == 1));
+    }
+
+    set.clear();
+    REQUIRE(set.empty());
+    REQUIRE(set.begin() == set.end());
+    REQUIRE(set.longest_probe() == 0);
+}
+
+TEST_CASE("rjh::static_unordered_set probe limit", "[rjh::static_unordered_set tests]") {
+    // Every key hashes to the same bucket, so the cluster grows by one bucket per insert until the limit refuses it.
+    static_unordered_set<int, 100, constant_hash> set;
+    for (auto i = 0; i <= static_cast<int>(set.probe_limit); i++) {
+        REQUIRE(set.insert(i).second);
+    }
+    REQUIRE(set.longest_probe() == set.probe_limit);
+    REQUIRE_FALSE(set.insert(1000).second);
+    REQUIRE(set.size() == set.probe_limit + 1);
+
+    for (auto i = 0; i <= static_cast<int>(set.probe_limit); i++) {
+        REQUIRE(set.contains(i));
+    }
+    REQUIRE_FALSE(set.contains(1000));
+
+    REQUIRE(set.erase(0));
+    REQUIRE(set.longest_probe() == set.probe_limit - 1);
+    REQUIRE(set.insert(1000).second);
+}
+
+TEST_CASE("rjh::static_unordered_set erase_if with a wrapped cluster", "[rjh::static_unordered_set tests]") {
+    static_unordered_set<int, 8, last_bucket_hash> set;
+    REQUIRE(set.bucket_count() == 16);
+    for (auto i = 0; i < 6; i++) {
+        REQUIRE(set.insert(i).second);
+    }
+
+    // Removing the entry in the last bucket shifts the entries from the start of the array behind it.
+    auto calls = 0;
+    REQUIRE(set.erase_if([&calls](int key) {
+        calls++;
+        return key % 2 == 0;
+    }) == 3);
+    REQUIRE(calls == 6);
+    REQUIRE(set.size() == 3);
+    for (auto i = 0; i < 6; i++) {
+        REQUIRE(set.contains(i) == (i % 2 == 1));
+    }
+}
+
+TEST_CASE("rjh::static_unordered_set stays within its probe limit when nearly full", "[rjh::static_unordered_set tests]") {
+    // 3071 keys fill 4096 buckets to three quarters, the densest a static table gets.
+    auto set = std::make_unique<static_unordered_set<std::uint64_t, 3071>>();
+    REQUIRE(set->bucket_count() == 4096);
+    for (std::uint64_t i = 0; i < 3071; i++) {
+        REQUIRE(set->insert(i * 0x9e3779b97f4a7c15ull).second);
+    }
+    REQUIRE(set->longest_probe() <= set->probe_limit);
+    for (std::uint64_t i = 0; i < 3071; i++) {
+        REQUIRE(set->contains(i * 0x9e3779b97f4a7c15ull));
+    }
+}
+} // namespace rjh::tests
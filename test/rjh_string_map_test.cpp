@@ -0,0 +1,105 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "rjh/string_map.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <utility>
+
+namespace rjh::tests {
+TEST_CASE("rjh::string_map<int>", "[rjh::string_map tests]") {
+    string_map<int> map;
+
+    for (auto i = 0; i < 1000; i++) {
+        REQUIRE(map.insert(std::to_string(i), i).second);
+    }
+    REQUIRE_FALSE(map.insert("500", 0).second);
+    REQUIRE(map.size() == 1000);
+
+    REQUIRE(map.find("500") != map.end());
+    REQUIRE(map.find("500").value() == 500);
+    REQUIRE(map.find(std::string{"999"}).key() == "999");
+    REQUIRE(map.find(std::string_view{"1000"}) == map.end());
+
+    const char* key = "42";
+    REQUIRE(map.contains(key));
+
+    for (auto i = 0; i < 1000; i += 2) {
+        REQUIRE(map.erase(std::to_string(i)));
+    }
+    REQUIRE_FALSE(map.erase("0"));
+    for (auto i = 0; i < 1000; i++) {
+        REQUIRE(map.contains(std::to_string(i)) == (i % 2 == 1));
+    }
+}
+
+TEST_CASE("rjh::string_map owns its keys", "[rjh::string_map tests]") {
+    string_map<int> map;
+    {
+        auto key = std::string(100, 'a');
+        map.insert(key, 1);
+        key.assign(100, 'b');
+    }
+    REQUIRE(map.contains(std::string(100, 'a')));
+    REQUIRE(map.insert("", 2).second);
+    REQUIRE(map.find("").value() == 2);
+
+    auto copy = map;
+    map.clear();
+    REQUIRE(map.empty());
+    REQUIRE(map.key_bytes() == 0);
+    REQUIRE(copy.size() == 2);
+    REQUIRE(copy.find(std::string(100, 'a')).value() == 1);
+
+    auto moved = std::move(copy);
+    REQUIRE(moved.find(std::string(100, 'a')).value() == 1);
+}
+
+TEST_CASE("rjh::string_map shrink_to_fit repacks keys", "[rjh::string_map tests]") {
+    string_map<int> map;
+    for (auto i = 0; i < 1000; i++) {
+        map.insert("key" + std::to_string(i), i);
+    }
+    const auto bytes = map.key_bytes();
+
+    REQUIRE(map.erase_if([](const auto& pair) { return pair.second >= 100; }) == 900);
+    REQUIRE(map.key_bytes() == bytes);
+    map.shrink_to_fit();
+    REQUIRE(map.key_bytes() < bytes / 5);
+    for (auto i = 0; i < 1000; i++) {
+        const auto it = map.find("key" + std::to_string(i));
+        REQUIRE((it != map.end()) == (i < 100));
+        if (it != map.end()) {
+            REQUIRE(it.value() == i);
+        }
+    }
+}
+
+TEST_CASE("rjh::string_map erase_if with shrink repacks keys", "[rjh::string_map tests]") {
+    string_map<int> map;
+    for (auto i = 0; i < 1000; i++) {
+        map.insert("key" + std::to_string(i), i);
+    }
+    const auto bytes = map.key_bytes();
+
+    REQUIRE(map.erase_if([](const auto& pair) { return pair.second >= 100; }, true) == 900);
+    REQUIRE(map.key_bytes() < bytes / 5);
+    for (auto i = 0; i < 100; i++) {
+        REQUIRE(map.find("key" + std::to_string(i)).value() == i);
+    }
+}
+} // namespace rjh::tests
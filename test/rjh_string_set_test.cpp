@@ -0,0 +1,49 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "rjh/string_set.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+namespace rjh::tests {
+TEST_CASE("rjh::string_set", "[rjh::string_set tests]") {
+    string_set set;
+
+    for (auto i = 0; i < 1000; i++) {
+        REQUIRE(set.insert(std::to_string(i)).second);
+    }
+    REQUIRE_FALSE(set.insert("7").second);
+    REQUIRE(*set.insert(std::string{"1000"}).first == "1000");
+    REQUIRE(set.size() == 1001);
+
+    REQUIRE(set.retain([](std::string_view key) { return key.size() == 1; }) == 991);
+    REQUIRE(set.size() == 10);
+    REQUIRE(set.contains("9"));
+    REQUIRE_FALSE(set.contains("10"));
+
+    auto copy = set;
+    set.shrink_to_fit();
+    REQUIRE(set.key_bytes() == 10);
+    REQUIRE(set.erase("5"));
+    REQUIRE(copy.contains("5"));
+    REQUIRE(copy.find("0") != copy.end());
+
+    REQUIRE(copy.erase_if([](std::string_view key) { return key != "0"; }, true) == 9);
+    REQUIRE(copy.key_bytes() == 1);
+    REQUIRE(copy.contains("0"));
+}
+} // namespace rjh::tests
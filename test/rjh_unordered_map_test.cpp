@@ -17,8 +17,10 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
 #include <iostream>
 #include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -59,4 +61,161 @@ TEST_CASE("rjh::unordered_map<custom_type, std::string>", "[rjh::unordered_map t
     unordered_map<custom_type, std::string, custom_type_hasher> map;
 
 }
+
+TEST_CASE("rjh::unordered_map erase_if and retain", "[rjh::unordered_map tests]") {
+    unordered_map<int, int> map;
+    for (auto i = 0; i < 1000; i++) {
+        map.insert({i, i * 2});
+    }
+
+    REQUIRE(map.erase_if([](const auto& pair) { return pair.first % 3 == 0; }) == 334);
+    REQUIRE(map.size() == 666);
+    for (auto i = 0; i < 1000; i++) {
+        REQUIRE(map.contains(i) == (i % 3 != 0));
+    }
+
+    const auto capacity = map.capacity();
+    REQUIRE(map.retain([](const auto& pair) { return pair.second < 100; }, true) == 633);
+    REQUIRE(map.size() == 33);
+    REQUIRE(map.capacity() < capacity);
+    for (auto i = 0; i < 1000; i++) {
+        REQUIRE(map.contains(i) == (i % 3 != 0 && i < 50));
+    }
+
+    map.insert({999, 0});
+    REQUIRE(map.contains(999));
+    REQUIRE(map.size() == 34);
+}
+
+TEST_CASE("rjh::unordered_map extract and insert node", "[rjh::unordered_map tests]") {
+    unordered_map<std::string, std::string> source, destination;
+    for (auto i = 0; i < 100; i++) {
+        source.insert({std::to_string(i), std::to_string(i * 2)});
+    }
+
+    REQUIRE(source.extract("not a key").empty());
+
+    for (auto i = 0; i < 100; i += 2) {
+        auto node = source.extract(std::to_string(i));
+        REQUIRE(node);
+        REQUIRE(node.key() == std::to_string(i));
+        node.value() += "!";
+        REQUIRE(destination.insert(std::move(node)).second);
+        REQUIRE(node.empty());
+    }
+
+    REQUIRE(source.size() == 50);
+    REQUIRE(destination.size() == 50);
+    for (auto i = 0; i < 100; i++) {
+        REQUIRE(source.contains(std::to_string(i)) == (i % 2 == 1));
+        REQUIRE(destination.contains(std::to_string(i)) == (i % 2 == 0));
+    }
+    REQUIRE(destination.find(std::string{"10"}).value() == "20!");
+
+    destination.insert({"1", "duplicate"});
+    auto node = source.extract(std::string{"1"});
+    const auto [it, inserted] = destination.insert(std::move(node));
+    REQUIRE_FALSE(inserted);
+    REQUIRE(it.value() == "duplicate");
+    REQUIRE(node.value() == "2");
+}
+
+TEST_CASE("rjh::unordered_map generational clear", "[rjh::unordered_map tests]") {
+    unordered_map<int, std::string, std::hash<int>, std::equal_to<int>, true> map;
+
+    // Enough rounds to wrap the 8-bit generation more than once.
+    for (auto round = 0; round < 600; round++) {
+        const auto first = round % 7;
+        for (auto i = first; i < first + 20; i++) {
+            REQUIRE(map.insert({i, std::to_string(i + round)}).second);
+        }
+        REQUIRE(map.size() == 20);
+        REQUIRE_FALSE(map.contains(first - 1));
+        REQUIRE(map.find(first + 19).value() == std::to_string(first + 19 + round));
+
+        auto count = 0;
+        for (auto it = map.begin(); it != map.end(); ++it) {
+            REQUIRE(it.value() == std::to_string(it.key() + round));
+            count++;
+        }
+        REQUIRE(count == 20);
+
+        REQUIRE(map.erase_if([first](const auto& pair) { return pair.first == first; }) == 1);
+        map.clear();
+        REQUIRE(map.empty());
+        REQUIRE(map.begin() == map.end());
+        REQUIRE_FALSE(map.contains(first + 1));
+    }
+}
+
+TEST_CASE("rjh::unordered_map aggregation", "[rjh::unordered_map tests]") {
+    std::vector<int> keys;
+    std::vector<long> values;
+    for (auto i = 0; i < 10000; i++) {
+        keys.push_back(i % 97);
+        values.push_back(i);
+    }
+
+    unordered_map<int, long> sums;
+    sums.aggregate(std::span<const int>{keys}, std::span<const long>{values}, [](long& sum, long value) {
+        sum += value;
+    });
+    unordered_map<int, long> maxima;
+    maxima.aggregate(std::span<const int>{keys}, std::span<const long>{values}, [](long& max, long value) {
+        max = std::max(max, value);
+    });
+    unordered_map<int, int> counts;
+    counts.aggregate(std::span<const int>{keys}, [](int& count) {
+        count++;
+    });
+
+    REQUIRE(sums.size() == 97);
+    REQUIRE(counts.size() == 97);
+    for (auto key = 0; key < 97; key++) {
+        auto sum = 0L;
+        auto max = 0L;
+        auto count = 0;
+        for (auto i = key; i < 10000; i += 97) {
+            sum += i;
+            max = i;
+            count++;
+        }
+        REQUIRE(sums.find(key).value() == sum);
+        REQUIRE(maxima.find(key).value() == max);
+        REQUIRE(counts.find(key).value() == count);
+    }
+
+    unordered_map<std::string, std::string> joined;
+    REQUIRE(joined.upsert_with("a", "x", [](std::string& value, const char* more) { value += more; }).second);
+    const auto [it, inserted] = joined.upsert_with("a", "y", [](std::string& value, const char* more) {
+        value += more;
+    });
+    REQUIRE_FALSE(inserted);
+    REQUIRE(it.value() == "xy");
+}
+
+TEST_CASE("rjh::unordered_map merge_with", "[rjh::unordered_map tests]") {
+    const auto add = [](int& total, int&& partial) {
+        total += partial;
+    };
+
+    unordered_map<int, int> total;
+    unordered_map<int, int> partial;
+    for (auto i = 0; i < 1000; i++) {
+        total.insert({i, 1});
+        partial.insert({i + 500, 2});
+    }
+
+    total.merge_with(partial, add);
+    REQUIRE(partial.empty());
+    REQUIRE(total.size() == 1500);
+    for (auto i = 0; i < 1500; i++) {
+        REQUIRE(total.find(i).value() == (i < 500 ? 1 : i < 1000 ? 3 : 2));
+    }
+
+    unordered_map<int, int> empty;
+    empty.merge_with(std::move(total), add);
+    REQUIRE(empty.size() == 1500);
+    REQUIRE(total.empty());
+}
 } // namespace rjh::tests
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "rjh/unordered_multimap.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+namespace rjh::tests {
+TEST_CASE("rjh::unordered_multimap<int, int>", "[rjh::unordered_multimap tests]") {
+    unordered_multimap<int, int> map;
+    for (auto i = 0; i < 100; i++) {
+        for (auto j = 0; j < i % 10; j++) {
+            map.insert({i, j});
+        }
+    }
+
+    REQUIRE(map.size() == 450);
+    for (auto i = 0; i < 100; i++) {
+        REQUIRE(map.count(i) == static_cast<std::size_t>(i % 10));
+        REQUIRE(map.contains(i) == (i % 10 != 0));
+
+        auto j = 0;
+        for (auto [it, last] = map.equal_range(i); it != last; ++it, ++j) {
+            REQUIRE(it.key() == i);
+            REQUIRE(it.value() == j);
+        }
+        REQUIRE(j == i % 10);
+    }
+
+    REQUIRE(map.erase(9) == 9);
+    REQUIRE(map.erase(9) == 0);
+    REQUIRE(map.count(9) == 0);
+    REQUIRE(map.size() == 441);
+
+    map.erase_if([](const auto& pair) { return pair.second >= 5; });
+    for (auto i = 0; i < 100; i++) {
+        REQUIRE(map.count(i) == static_cast<std::size_t>(i == 9 ? 0 : std::min(i % 10, 5)));
+    }
+}
+
+TEST_CASE("rjh::unordered_multimap<std::string, std::string>", "[rjh::unordered_multimap tests]") {
+    unordered_multimap<std::string, std::string> map;
+    map.insert({"a", "1"});
+    map.insert({"b", "2"});
+    map.insert({"a", "3"});
+
+    REQUIRE(map.count("a") == 2);
+    REQUIRE(map.count("c") == 0);
+
+    auto [it, last] = map.equal_range("a");
+    REQUIRE(it.value() == "1");
+    REQUIRE((++it).value() == "3");
+    REQUIRE(++it == last);
+}
+} // namespace rjh::tests
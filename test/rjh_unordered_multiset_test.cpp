@@ -0,0 +1,45 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "rjh/unordered_multiset.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace rjh::tests {
+TEST_CASE("rjh::unordered_multiset<int>", "[rjh::unordered_multiset tests]") {
+    unordered_multiset<int> set;
+    for (auto i = 0; i < 1000; i++) {
+        set.insert(i % 37);
+    }
+
+    REQUIRE(set.size() == 1000);
+    for (auto i = 0; i < 37; i++) {
+        const auto expected = static_cast<std::size_t>(i < 1000 % 37 ? 1000 / 37 + 1 : 1000 / 37);
+        REQUIRE(set.count(i) == expected);
+
+        auto [it, last] = set.equal_range(i);
+        std::size_t count = 0;
+        for (; it != last; ++it) {
+            REQUIRE(*it == i);
+            count++;
+        }
+        REQUIRE(count == expected);
+    }
+
+    REQUIRE(set.erase(0) == 28);
+    REQUIRE_FALSE(set.contains(0));
+    REQUIRE(set.count(1) == 27);
+}
+} // namespace rjh::tests
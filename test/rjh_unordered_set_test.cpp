@@ -17,13 +17,142 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <cstddef>
 #include <iostream>
 
 namespace rjh::tests {
 TEST_CASE("rjh::unordered_set<int>", "[rjh::unordered_set tests]") {
     unordered_set<int> set;
 
+    for (auto i = 0; i < 100; i++) {
+        REQUIRE(set.insert(i).second);
+    }
+    REQUIRE_FALSE(set.insert(50).second);
+    REQUIRE(set.size() == 100);
+    REQUIRE(set.find(50) != set.end());
+    REQUIRE(set.find(100) == set.end());
 
+    for (auto i = 0; i < 100; i += 2) {
+        REQUIRE(set.erase(i));
+    }
+    REQUIRE_FALSE(set.erase(0));
+    REQUIRE(set.size() == 50);
+    for (auto i = 0; i < 100; i++) {
+        REQUIRE(set.contains(i) == (i % 2 == 1));
+    }
+}
+
+TEST_CASE("rjh::unordered_set erase_if and retain", "[rjh::unordered_set tests]") {
+    unordered_set<int> set;
+    for (auto i = 0; i < 1000; i++) {
+        set.insert(i);
+    }
+
+    REQUIRE(set.erase_if([](int key) { return key >= 500; }) == 500);
+    REQUIRE(set.retain([](int key) { return key % 5 == 0; }, true) == 400);
+    REQUIRE(set.size() == 100);
+    for (auto i = 0; i < 1000; i++) {
+        REQUIRE(set.contains(i) == (i < 500 && i % 5 == 0));
+    }
+}
+
+TEST_CASE("rjh::unordered_set sparse iteration", "[rjh::unordered_set tests]") {
+    unordered_set<int> set;
+    set.reserve(100000);
+    REQUIRE(set.begin() == set.end());
+
+    for (auto i = 0; i < 1000; i++) {
+        set.insert(i * 7);
+    }
+
+    auto count = std::size_t{0};
+    auto sum = 0;
+    for (const auto key : set) {
+        count++;
+        sum += key;
+    }
+    REQUIRE(count == 1000);
+    REQUIRE(sum == 7 * 999 * 1000 / 2);
+
+    set.erase_if([](int key) { return key % 100 != 0; });
+    count = 0;
+    for (const auto key : set) {
+        REQUIRE(key % 100 == 0);
+        count++;
+    }
+    REQUIRE(count == set.size());
+
+    set.clear();
+    REQUIRE(set.begin() == set.end());
+    set.insert(3);
+    REQUIRE(*set.begin() == 3);
+}
+
+TEST_CASE("rjh::unordered_set set operations", "[rjh::unordered_set tests]") {
+    const auto make_range = [](int first, int last) {
+        unordered_set<int> set;
+        for (auto i = first; i < last; i++) {
+            set.insert(i);
+        }
+        return set;
+    };
+
+    SECTION("merge") {
+        auto a = make_range(0, 100);
+        auto b = make_range(50, 300);
+        a.merge(b);
+        REQUIRE(a.size() == 300);
+        REQUIRE(b.size() == 50);
+        for (auto i = 50; i < 100; i++) {
+            REQUIRE(b.contains(i));
+        }
+
+        unordered_set<int> empty;
+        empty.merge(a);
+        REQUIRE(empty.size() == 300);
+        REQUIRE(a.empty());
+    }
+
+    SECTION("union_with") {
+        auto a = make_range(0, 10);
+        a.union_with(make_range(5, 1000));
+        REQUIRE(a.size() == 1000);
+
+        auto b = make_range(0, 1000);
+        b.union_with(make_range(995, 1005));
+        REQUIRE(b.size() == 1005);
+    }
+
+    SECTION("intersect_with") {
+        auto a = make_range(0, 100);
+        a.intersect_with(make_range(90, 1000));
+        REQUIRE(a.size() == 10);
+
+        auto b = make_range(0, 1000);
+        b.intersect_with(make_range(990, 1010));
+        REQUIRE(b.size() == 10);
+        for (auto i = 990; i < 1000; i++) {
+            REQUIRE(b.contains(i));
+        }
+    }
+
+    SECTION("difference_with") {
+        auto a = make_range(0, 100);
+        a.difference_with(make_range(10, 1000));
+        REQUIRE(a.size() == 10);
+
+        auto b = make_range(0, 1000);
+        b.difference_with(make_range(10, 20));
+        REQUIRE(b.size() == 990);
+        REQUIRE_FALSE(b.contains(15));
+    }
+
+    SECTION("is_subset_of") {
+        REQUIRE(make_range(10, 20).is_subset_of(make_range(0, 100)));
+        REQUIRE_FALSE(make_range(90, 110).is_subset_of(make_range(0, 100)));
+        REQUIRE_FALSE(make_range(0, 100).is_subset_of(make_range(10, 20)));
+        REQUIRE(unordered_set<int>{}.is_subset_of(make_range(0, 1)));
+    }
 }
 
 TEST_CASE("rjh::unordered_set<std::string>", "[rjh::unordered_set tests]") {
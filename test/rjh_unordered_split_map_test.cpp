@@ -0,0 +1,100 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "rjh/unordered_split_map.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+namespace rjh::tests {
+namespace {
+struct no_default {
+    explicit no_default(int) noexcept {}
+};
+
+template<typename Value>
+concept storable = requires {
+    typename unordered_split_map<int, Value>;
+};
+
+// Erased slots are reset to a default-constructed value, so a mapped type without one is rejected up front.
+static_assert(storable<std::string>);
+static_assert(!storable<no_default>);
+} // namespace
+
+TEST_CASE("rjh::unordered_split_map<int, std::string>", "[rjh::unordered_split_map tests]") {
+    unordered_split_map<int, std::string> map;
+
+    for (auto i = 0; i < 1000; i++) {
+        REQUIRE(map.insert({i, std::to_string(i)}).second);
+    }
+    REQUIRE_FALSE(map.insert({10, "ten"}).second);
+    REQUIRE(map.size() == 1000);
+    REQUIRE(map.find(10).value() == "10");
+    REQUIRE(map.find(1000) == map.end());
+
+    map.find(20).value() = "twenty";
+    REQUIRE(map.find(20).value() == "twenty");
+
+    for (auto i = 0; i < 1000; i += 2) {
+        REQUIRE(map.erase(i));
+    }
+    REQUIRE_FALSE(map.erase(0));
+    REQUIRE(map.size() == 500);
+
+    for (auto i = 1000; i < 1500; i++) {
+        REQUIRE(map.insert({i, std::to_string(i)}).second);
+    }
+
+    auto count = std::size_t{0};
+    for (const auto [key, value] : map) {
+        REQUIRE((key % 2 == 1 || key >= 1000));
+        REQUIRE(value == std::to_string(key));
+        count++;
+    }
+    REQUIRE(count == 1000);
+
+    const auto& const_map = map;
+    REQUIRE(const_map.find(1499).value() == "1499");
+    REQUIRE(const_map.contains(1));
+    REQUIRE_FALSE(const_map.contains(2));
+
+    map.clear();
+    REQUIRE(map.empty());
+    REQUIRE(map.begin() == map.end());
+}
+
+TEST_CASE("rjh::unordered_split_map with a large mapped type", "[rjh::unordered_split_map tests]") {
+    using payload = std::array<int, 64>;
+    unordered_split_map<std::size_t, payload> map;
+
+    for (std::size_t i = 0; i < 100; i++) {
+        payload value{};
+        value.fill(static_cast<int>(i));
+        map.insert({i, value});
+    }
+
+    auto copy = map;
+    for (std::size_t i = 0; i < 100; i++) {
+        REQUIRE(map.erase(i));
+        REQUIRE(copy.find(i).value()[63] == static_cast<int>(i));
+    }
+    REQUIRE(map.empty());
+    REQUIRE(copy.size() == 100);
+}
+} // namespace rjh::tests
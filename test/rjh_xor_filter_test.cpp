@@ -0,0 +1,63 @@
+/*
+ * Copyright 2024 Ryan Jeffares (ryan.jeffares.business@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the “Software”), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions: The above copyright
+ * notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "rjh/unordered_set.hpp"
+#include "rjh/xor_filter.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <vector>
+
+namespace rjh::tests {
+TEST_CASE("rjh::xor_filter built from an unordered_set", "[rjh::xor_filter tests]") {
+    unordered_set<int> set;
+    for (auto i = 0; i < 100000; i++) {
+        set.insert(i * 3);
+    }
+
+    const xor_filter<int> filter{set};
+    REQUIRE(filter.size() == 100000);
+    REQUIRE(filter.size_in_bytes() < 100000 * 10 / 8 + 64);
+
+    for (const auto key : set) {
+        REQUIRE(filter.contains(key));
+    }
+
+    auto false_positives = 0;
+    for (auto i = 0; i < 300000; i++) {
+        if (i % 3 != 0) {
+            false_positives += filter.contains(i);
+        }
+    }
+    // About 1/256 of 200000 misses, with generous slack.
+    REQUIRE(false_positives < 1500);
+}
+
+TEST_CASE("rjh::xor_filter edge cases", "[rjh::xor_filter tests]") {
+    const xor_filter<std::string> empty;
+    REQUIRE_FALSE(empty.contains("anything"));
+
+    const xor_filter<std::string> none{std::vector<std::string>{}};
+    REQUIRE(none.size() == 0);
+    REQUIRE_FALSE(none.contains(""));
+
+    const xor_filter<std::string> duplicates{std::vector<std::string>{"a", "b", "a", "c", "b"}};
+    REQUIRE(duplicates.size() == 3);
+    REQUIRE(duplicates.contains("a"));
+    REQUIRE(duplicates.contains("b"));
+    REQUIRE(duplicates.contains("c"));
+}
+} // namespace rjh::tests